@@ -67,8 +67,15 @@ typedef G4THitsCollection<Geant4PreDigiTrackHit> Geant4PreDigiTrackHitsCollectio
 
 extern G4ThreadLocal G4Allocator<Geant4PreDigiTrackHit>* Geant4PreDigiTrackHitAllocator;
 
+/// Growth factor of the allocator pages (default pages of 1 kB hold only a handful of hits)
+const unsigned int Geant4PreDigiTrackHitPageGrowth = 64;
+
 inline void* Geant4PreDigiTrackHit::operator new(size_t) {
-  if (!Geant4PreDigiTrackHitAllocator) Geant4PreDigiTrackHitAllocator = new G4Allocator<Geant4PreDigiTrackHit>;
+  if (!Geant4PreDigiTrackHitAllocator) {
+    // one pool per thread, with large pages: the hits freed at the end of an event are reused in the next one
+    Geant4PreDigiTrackHitAllocator = new G4Allocator<Geant4PreDigiTrackHit>;
+    Geant4PreDigiTrackHitAllocator->IncreasePageSize(Geant4PreDigiTrackHitPageGrowth);
+  }
   return (void*)Geant4PreDigiTrackHitAllocator->MallocSingle();
 }
 
@@ -4,8 +4,11 @@
 #include "DDSegmentation/Segmentation.h"
 
 #include "TVector3.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <map>
+#include <vector>
 
 /** GridDriftChamber Detector/DetSegmentation/DetSegmentation/GridDriftChamber.h GridDriftChamber.h
  *
@@ -42,28 +45,62 @@ public:
   // Setters
   inline void setEpsilon(double aEpsilon) { m_epsilon = aEpsilon; }
 
+  /// Geometry of a layer, computed once in setGeomParams() so that all queries are pure functions of it
+  struct LayerGeometry {
+    bool defined = false;
+    double gridSizePhi = 0;  // phi pitch of the wires
+    double radius = 0;       // radius of the wire ends
+    double epsilon = 0;      // stereo angle
+    double alpha = 0;        // phi rotation of the wire between its two ends
+    double cosAlpha = 1;
+    double sinAlpha = 0;
+  };
+
   inline void setGeomParams(int layer, double sizePhi, double R, double eps) {
-    layer_params[layer] = {sizePhi, R, eps};
+    if (size_t(layer) >= m_layers.size()) {
+      m_layers.resize(layer + 1);
+      m_wireEnds.resize(layer + 1);
+    }
+    LayerGeometry& geometry = m_layers[layer];
+    geometry.defined = true;
+    geometry.gridSizePhi = sizePhi;
+    geometry.radius = R;
+    geometry.epsilon = eps;
+    geometry.alpha = 2 * std::asin(m_detectorLength * std::tan(eps) / (2 * R));
+    geometry.cosAlpha = std::cos(geometry.alpha);
+    geometry.sinAlpha = std::sin(geometry.alpha);
+    m_lastLayer = std::max(m_lastLayer, layer);
+  }
+
+  inline void setWiresInLayer(int layer, int numWires) {
+    const LayerGeometry& geometry = layerGeometry(layer);
+    m_wireEnds[layer].clear();
+    m_wireEnds[layer].reserve(numWires);
+    for (int i = 0; i < numWires; ++i) {
+      auto phi_start = geometry.gridSizePhi * i;
+      auto phi_end = phi_start + geometry.alpha;
+
+      TVector3 Wstart = returnWirePosition(geometry, phi_start, 1);
+      TVector3 Wend = returnWirePosition(geometry, phi_end, -1);
+
+      TVector3 Wmid = (Wstart + Wend) * (1 / 2.0);
+      TVector3 Wdirection = (Wend - Wstart);
+
+      m_wiresPositions[layer].push_back(std::make_pair(Wmid, Wdirection));
+      m_wireEnds[layer].push_back(std::make_pair(Wstart, Wend));
+    }
+  }
+  inline const std::map<int, std::vector<std::pair<TVector3, TVector3>>>& returnAllWires() const {
+    return m_wiresPositions;
   }
 
-  inline void setWiresInLayer(int layer, int numWires)
-  {
-    updateParams(layer);
-    for (int i = 0; i<numWires; ++i)
-      {
-	auto phi_start = _currentGridSizePhi* i;
-	auto phi_end = phi_start + returnAlpha();
-
-	TVector3 Wstart = returnWirePosition(phi_start, 1);
-	TVector3 Wend = returnWirePosition(phi_end, -1);
-	
-	TVector3 Wmid = (Wstart+Wend)*(1/2.0);
-	TVector3 Wdirection = (Wend - Wstart);
-
-	m_wiresPositions[layer].push_back(std::make_pair(Wmid, Wdirection));
-      }
+  /// Geometry of the layer; layers that were not set use the geometry of the last layer
+  inline const LayerGeometry& layerGeometry(int layer) const {
+    if (layer >= 0 && size_t(layer) < m_layers.size() && m_layers[layer].defined) {
+      return m_layers[layer];
+    }
+    return m_layers[m_lastLayer];
   }
-  inline auto returnAllWires() const {return m_wiresPositions; }
 
   TVector3 LineLineIntersect(TVector3 p1, TVector3 p2, TVector3 p3, TVector3 p4) const {
     TVector3 p13, p43, p21;
@@ -110,27 +147,7 @@ public:
     return pb - pa;
   }
 
-  void updateParams(int layer) const {
-    auto it_end = layer_params.cend();
-    --it_end;
-    double size = it_end->second[0];
-    double radius = it_end->second[1];
-    double eps = it_end->second[2];
-
-    auto map_it = layer_params.find(layer);
-    if (map_it != layer_params.cend()) {
-      size = map_it->second[0];
-      radius = map_it->second[1];
-      eps = map_it->second[2];
-    }
-
-    _currentGridSizePhi = size;
-    _currentRadius = radius;
-    m_epsilon = eps;
-  }
-
-  inline double debug_projectToXY(const TVector3& pos) const {
-    double gridSizePhi = _currentGridSizePhi;
+  inline double debug_projectToXY(const LayerGeometry& geometry, const TVector3& pos) const {
     double _phi = pos.Phi();
     if (_phi < 0) {
       _phi += 2 * M_PI;
@@ -138,27 +155,24 @@ public:
 
     // distance between X,Y and the projected position of the Z on the (X,Y) plane
 
-    double _L = (m_detectorLength / 2. - pos.Z()) * std::tan(m_epsilon);
+    double _L = (m_detectorLength / 2. - pos.Z()) * std::tan(geometry.epsilon);
     double sign = 1.;
     if (_L < 0) {
       sign = -1;
     }
-    double _crd = _L * sign / _currentRadius;  // _crd>0
+    double _crd = _L * sign / geometry.radius;  // _crd>0
     double _theta = 2 * std::asin(_crd / 2) * sign;
     double _totalAngle = _phi + _theta;
     if (_totalAngle < 0) {
       _totalAngle += 2 * M_PI;
     }
-    int wire = int(_totalAngle / gridSizePhi);
-
     return _totalAngle;
   }
 
-  inline Vector3D returnPosWire0(double z) const {
-    double alpha = returnAlpha();
+  inline Vector3D returnPosWire0(const LayerGeometry& geometry, double z) const {
     double t = 0.5 * (1 - 2.0 * z / m_detectorLength);
-    double x = _currentRadius * (1 + t * (std::cos(alpha) - 1));
-    double y = _currentRadius * t * std::sin(alpha);
+    double x = geometry.radius * (1 + t * (geometry.cosAlpha - 1));
+    double y = geometry.radius * t * geometry.sinAlpha;
 
     Vector3D vec(x, y, z);
     return vec;
@@ -166,15 +180,14 @@ public:
 
   inline double phiFromXY(const Vector3D& aposition) const { return std::atan2(aposition.Y, aposition.X) + M_PI; }
 
-  inline double projectToXY(const Vector3D& aposition) const {
-    double gridSizePhi = _currentGridSizePhi;
+  inline double projectToXY(const LayerGeometry& geometry, const Vector3D& aposition) const {
     // aposition is a global position
     double _phi = phiFromXY(aposition);
 
     // distance between X,Y and the projected position of the Z on the (X,Y) plane
-    double _L = (m_detectorLength / 2. - aposition.Z) * std::tan(m_epsilon);
+    double _L = (m_detectorLength / 2. - aposition.Z) * std::tan(geometry.epsilon);
     // Chord
-    double _crd = _L / _currentRadius;
+    double _crd = _L / geometry.radius;
 
     double _theta = 2 * std::asin(_crd / 2);
     double _totalAngle = _phi + _theta;
@@ -183,22 +196,15 @@ public:
     if (_totalAngle < 0) {
       _totalAngle += 2 * M_PI;
     }
-
-    int wire = int(_totalAngle / gridSizePhi);
     return _totalAngle;
   }
 
-  inline double returnAlpha() const {
-    double alpha = 2 * std::asin(m_detectorLength * std::tan(m_epsilon) / (2 * _currentRadius));
-    return alpha;
-  }
+  inline double returnAlpha(const LayerGeometry& geometry) const { return geometry.alpha; }
 
-  inline TVector3 returnWirePosition(double angle, int sign) const {
+  inline TVector3 returnWirePosition(const LayerGeometry& geometry, double angle, int sign) const {
     TVector3 w(0, 0, 0);
-    // std::cout << "returnWirePosition: _currentRadius: " << _currentRadius << std::endl;
-
-    w.SetX(_currentRadius * std::cos(angle));
-    w.SetY(_currentRadius * std::sin(angle));
+    w.SetX(geometry.radius * std::cos(angle));
+    w.SetY(geometry.radius * std::sin(angle));
     w.SetZ(sign * m_detectorLength / 2.0);
     return w;
   }
@@ -214,21 +220,21 @@ public:
 
 protected:
   /* *** nalipour *** */
-  double phi(const CellID& cID) const;
+  double phi(const LayerGeometry& geometry, const CellID& cID) const;
+  /// Ends of the wire of the cell (at z = +L/2 and z = -L/2), from the table filled by setWiresInLayer() if possible
+  void wireEnds(const CellID& cID, TVector3& Wstart, TVector3& Wend) const;
 
-  std::map<int, std::vector<double>> layer_params;  // <layer, {phi, R, eps}>
+  std::vector<LayerGeometry> m_layers;  // indexed by layer
+  int m_lastLayer = 0;                  // highest layer set, used for the layers without geometry
   std::map<int, std::vector<std::pair<TVector3, TVector3> >> m_wiresPositions;   // < layer, vec<WireMidpoint, WireDirection> >
+  std::vector<std::vector<std::pair<TVector3, TVector3>>> m_wireEnds;  // [layer][wire] = <WireStart, WireEnd>
 
   double m_innerRadius;  // R0 // [cm]
   double m_cellSize;
   double m_detectorLength;
   double m_offsetPhi;
   std::string m_phiID;
-
-  // Current parameters of the layer: sizePhi
-  mutable double _currentGridSizePhi;  // current size Phi
-  mutable double _currentRadius;       // current size radius
-  mutable double m_epsilon;
+  double m_epsilon = 0;
 };
 }
 }
@@ -31,11 +31,12 @@ GridDriftChamber::GridDriftChamber(const BitFieldCoder* decoder) : Segmentation(
   registerIdentifier("identifier_phi", "Cell ID identifier for phi", m_phiID, "phi");
 }
 
-Vector3D GridDriftChamber::position(const CellID& cID) const {  //// ???? TODO
-
-  Vector3D cellPosition = {0, 0, 0};
-
-  return cellPosition;
+Vector3D GridDriftChamber::position(const CellID& cID) const {
+  // middle of the wire (z = 0)
+  TVector3 Wstart, Wend;
+  wireEnds(cID, Wstart, Wend);
+  TVector3 Wmid = (Wstart + Wend) * (1 / 2.0);
+  return Vector3D(Wmid.X(), Wmid.Y(), Wmid.Z());
 }
 
 CellID GridDriftChamber::cellID(const Vector3D& /*localPosition*/, const Vector3D& globalPosition,
@@ -43,37 +44,48 @@ CellID GridDriftChamber::cellID(const Vector3D& /*localPosition*/, const Vector3
 
   CellID cID = vID;
   unsigned int layerID = _decoder->get(vID, "layer");
-  updateParams(layerID);
+  const LayerGeometry& geometry = layerGeometry(layerID);
 
   double phi_hit = phiFromXY(globalPosition);
   double posz = globalPosition.Z;
-  Vector3D wire0 = returnPosWire0(posz);
+  Vector3D wire0 = returnPosWire0(geometry, posz);
   double phi_wire0 = phiFromXY(wire0);
   double lphi = phi_hit - phi_wire0;
   if (lphi < 0) {
     lphi += 2 * M_PI;
   }
 
-  _decoder->set(cID, m_phiID, positionToBin(lphi, _currentGridSizePhi, m_offsetPhi));
+  _decoder->set(cID, m_phiID, positionToBin(lphi, geometry.gridSizePhi, m_offsetPhi));
   return cID;
 }
 
-double GridDriftChamber::phi(const CellID& cID) const {
+double GridDriftChamber::phi(const LayerGeometry& geometry, const CellID& cID) const {
   CellID phiValue = _decoder->get(cID, m_phiID);
-  return binToPosition(phiValue, _currentGridSizePhi, m_offsetPhi);
+  return binToPosition(phiValue, geometry.gridSizePhi, m_offsetPhi);
+}
+
+void GridDriftChamber::wireEnds(const CellID& cID, TVector3& Wstart, TVector3& Wend) const {
+  int layerIndex = _decoder->get(cID, "layer");
+  int wireIndex = _decoder->get(cID, m_phiID);
+  // wires of the table are placed without phi offset
+  if (m_offsetPhi == 0 && layerIndex >= 0 && size_t(layerIndex) < m_wireEnds.size() && wireIndex >= 0 &&
+      size_t(wireIndex) < m_wireEnds[layerIndex].size()) {
+    Wstart = m_wireEnds[layerIndex][wireIndex].first;
+    Wend = m_wireEnds[layerIndex][wireIndex].second;
+    return;
+  }
+  const LayerGeometry& geometry = layerGeometry(layerIndex);
+  double phi_start = phi(geometry, cID);
+  double phi_end = phi_start + geometry.alpha;
+  Wstart = returnWirePosition(geometry, phi_start, 1);
+  Wend = returnWirePosition(geometry, phi_end, -1);
 }
 
 // Distance between a particle track and a wire
 double GridDriftChamber::distanceTrackWire(const CellID& cID, const TVector3& hit_start,
                                            const TVector3& hit_end) const {
-  auto layerIndex = _decoder->get(cID, "layer");
-  updateParams(layerIndex);
-
-  double phi_start = phi(cID);
-  double phi_end = phi_start + returnAlpha();
-
-  TVector3 Wstart = returnWirePosition(phi_start, 1);
-  TVector3 Wend = returnWirePosition(phi_end, -1);
+  TVector3 Wstart, Wend;
+  wireEnds(cID, Wstart, Wend);
 
   TVector3 a = hit_end - hit_start;
   TVector3 b = Wend - Wstart;
@@ -96,14 +108,8 @@ double GridDriftChamber::distanceTrackWire(const CellID& cID, const TVector3& hi
 TVector3 GridDriftChamber::Line_TrackWire(const CellID& cID, const TVector3& hit_start, const TVector3& hit_end) const {
   // The line connecting a particle track to the closest wire
   // Returns the vector connecting the both
-  auto layerIndex = _decoder->get(cID, "layer");
-  updateParams(layerIndex);
-
-  double phi_start = phi(cID);
-  double phi_end = phi_start + returnAlpha();
-
-  TVector3 Wstart = returnWirePosition(phi_start, 1);
-  TVector3 Wend = returnWirePosition(phi_end, -1);
+  TVector3 Wstart, Wend;
+  wireEnds(cID, Wstart, Wend);
 
   TVector3 P1 = hit_start;
   TVector3 P2 = hit_end;
@@ -116,25 +122,11 @@ TVector3 GridDriftChamber::Line_TrackWire(const CellID& cID, const TVector3& hit
 
 TVector3 GridDriftChamber::distanceClosestApproach(const CellID& cID, const TVector3& hitPos) const {
   // Distance of the closest approach between a single hit (point) and the closest wire
+  TVector3 Wstart, Wend;
+  wireEnds(cID, Wstart, Wend);
 
-  auto layerIndex = _decoder->get(cID, "layer");
-  updateParams(layerIndex);
-  // std::cout << "segmentation: layer:" << layerIndex << std::endl;
-
-  double phi_start = phi(cID);
-  double phi_end = phi_start + returnAlpha();
-
-  TVector3 Wstart = returnWirePosition(phi_start, 1);
-  TVector3 Wend = returnWirePosition(phi_end, -1);
-  TVector3 temp = (Wend + Wstart);
-  TVector3 Wmid(temp.X() / 2.0, temp.Y() / 2.0, temp.Z() / 2.0);
-
-  double hitPhi = hitPos.Phi();
-  if (hitPhi < 0) {
-    hitPhi = hitPhi + 2 * M_PI;
-  }
-
-  TVector3 PCA = Wstart + ((Wend - Wstart).Unit()).Dot((hitPos - Wstart)) * ((Wend - Wstart).Unit());
+  TVector3 wireDirection = (Wend - Wstart).Unit();
+  TVector3 PCA = Wstart + wireDirection.Dot((hitPos - Wstart)) * wireDirection;
   TVector3 dca = hitPos - PCA;
 
   return dca;
@@ -142,14 +134,8 @@ TVector3 GridDriftChamber::distanceClosestApproach(const CellID& cID, const TVec
 
 // Get the wire position for a z
 TVector3 GridDriftChamber::wirePos_vs_z(const CellID& cID, const double& zpos) const {
-  auto layerIndex = _decoder->get(cID, "layer");
-  updateParams(layerIndex);
-
-  double phi_start = phi(cID);
-  double phi_end = phi_start + returnAlpha();
-
-  TVector3 Wstart = returnWirePosition(phi_start, 1);
-  TVector3 Wend = returnWirePosition(phi_end, -1);
+  TVector3 Wstart, Wend;
+  wireEnds(cID, Wstart, Wend);
 
   double t = (zpos - Wstart.Z())/(Wend.Z()-Wstart.Z());
   double x = Wstart.X()+t*(Wend.X()-Wstart.X());
@@ -9,12 +9,18 @@
 #include "G4THitsCollection.hh"
 #include "G4VSensitiveDetector.hh"
 
+#include <unordered_map>
+#include <vector>
+
 /** AggregateCalorimeterSD DetectorDescription/DetSensitive/src/AggregateCalorimeterSD.h AggregateCalorimeterSD.h
  *
  *  Sensitive detector for calorimeter (aggregates energy deposits within each cell).
  *  It is based on dd4hep::sim::Geant4GenericSD<Calorimeter> (but it is not identical).
  *  In particular, the position of the hit is set to G4Step::GetPreStepPoint() position.
  *  No timing information is saved (energy deposits are aggregated in the cells)
+ *  Hits are looked up by cellID in a hash map that is reset for each event.
+ *  In the deferred mode the steps are buffered and aggregated only at the end of event,
+ *  by sorting them in cellID and creating one hit per segment of equal cellID.
  *
  *  @author    Anna Zaborowska
  */
@@ -26,10 +32,12 @@ public:
    *  @param aDetectorName Name of the detector
    *  @param aReadoutName Name of the readout (used to name the collection)
    *  @param aSeg Segmentation of the detector (used to retrieve the cell ID)
+   *  @param aDeferredAggregation Flag whether to buffer the steps and aggregate them at the end of event
    */
   AggregateCalorimeterSD(const std::string& aDetectorName,
                          const std::string& aReadoutName,
-                         const dd4hep::Segmentation& aSeg);
+                         const dd4hep::Segmentation& aSeg,
+                         bool aDeferredAggregation = false);
   /// Destructor
   virtual ~AggregateCalorimeterSD();
   /** Initialization.
@@ -43,11 +51,29 @@ public:
    *  saves that into the hit collection.
    *  If there is already entry in the same cell, the energy is accumulated.
    *  Otherwise new hit is created.
+   *  In the deferred mode the step is only buffered.
    *  @param aStep Step in which particle deposited the energy.
    */
   virtual bool ProcessHits(G4Step* aStep, G4TouchableHistory*) final;
+  /** End of event.
+   *  In the deferred mode, aggregates the buffered steps into hits and fills the hit collection.
+   *  @param aHitsCollections Geant hits collection.
+   */
+  virtual void EndOfEvent(G4HCofThisEvent* aHitsCollections) final;
 
 private:
+  /// Energy deposit buffered in the deferred mode
+  struct Deposit {
+    uint64_t cellID;
+    double energy;
+    dd4hep::Position position;
+  };
+  /// Flag whether the steps are aggregated at the end of event
+  bool m_deferredAggregation;
+  /// Map of cellID to the index of the hit in the collection, reset for each event
+  std::unordered_map<uint64_t, int> m_hitIndexOfCell;
+  /// Energy deposits buffered in the deferred mode, cleared for each event
+  std::vector<Deposit> m_deposits;
   /// Collection of calorimeter hits
   G4THitsCollection<dd4hep::sim::Geant4CalorimeterHit>* m_calorimeterCollection;
   /// Segmentation of the detector used to retrieve the cell Ids
@@ -29,8 +29,10 @@ public:
    *  @param aDetectorName Name of the detector
    *  @param aReadoutName Name of the readout (used to name the collection)
    *  @param aSeg Segmentation of the detector (used to retrieve the cell ID)
+   *  @param aCoalesceSteps Flag whether consecutive steps of a track in the same cell are merged into one hit
    */
-  SimpleTrackerSD(const std::string& aDetectorName, const std::string& aReadoutName, const dd4hep::Segmentation& aSeg);
+  SimpleTrackerSD(const std::string& aDetectorName, const std::string& aReadoutName, const dd4hep::Segmentation& aSeg,
+                  bool aCoalesceSteps = false);
   /// Destructor
   virtual ~SimpleTrackerSD();
   /** Initialization.
@@ -52,6 +54,10 @@ private:
   G4THitsCollection<fcc::Geant4PreDigiTrackHit>* m_trackerCollection;
   /// Segmentation of the detector used to retrieve the cell Ids
   dd4hep::Segmentation m_seg;
+  /// Flag whether consecutive steps of a track in the same cell are merged into one hit
+  bool m_coalesceSteps;
+  /// Last hit created in the current event, extended by the following steps if m_coalesceSteps
+  fcc::Geant4PreDigiTrackHit* m_lastHit;
 };
 }
 
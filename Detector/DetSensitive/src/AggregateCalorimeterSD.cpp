@@ -13,11 +13,17 @@
 // Geant4
 #include "G4SDManager.hh"
 
+#include <algorithm>
+
 namespace det {
 AggregateCalorimeterSD::AggregateCalorimeterSD(const std::string& aDetectorName,
                                                const std::string& aReadoutName,
-                                               const dd4hep::Segmentation& aSeg)
-    : G4VSensitiveDetector(aDetectorName), m_calorimeterCollection(nullptr), m_seg(aSeg) {
+                                               const dd4hep::Segmentation& aSeg,
+                                               bool aDeferredAggregation)
+    : G4VSensitiveDetector(aDetectorName),
+      m_deferredAggregation(aDeferredAggregation),
+      m_calorimeterCollection(nullptr),
+      m_seg(aSeg) {
   // name of the collection of hits is determined byt the readout name (from XML)
   collectionName.insert(aReadoutName);
 }
@@ -31,6 +37,8 @@ void AggregateCalorimeterSD::Initialize(G4HCofThisEvent* aHitsCollections) {
       new G4THitsCollection<dd4hep::sim::Geant4CalorimeterHit>(SensitiveDetectorName, collectionName[0]);
   aHitsCollections->AddHitsCollection(G4SDManager::GetSDMpointer()->GetCollectionID(m_calorimeterCollection),
                                       m_calorimeterCollection);
+  m_hitIndexOfCell.clear();
+  m_deposits.clear();
 }
 
 bool AggregateCalorimeterSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
@@ -45,23 +53,46 @@ bool AggregateCalorimeterSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
   dd4hep::Position pos(midPos.x(), midPos.y(), midPos.z());
   // check the cell ID
   uint64_t id = utils::cellID(m_seg, *aStep);
-  dd4hep::sim::Geant4CalorimeterHit* hit = nullptr;
-  dd4hep::sim::Geant4CalorimeterHit* hitMatch = nullptr;
+  if (m_deferredAggregation) {
+    m_deposits.push_back({id, edep, pos});
+    return true;
+  }
   // Check if there is already some energy deposit in that cell
-  for (int i = 0; i < m_calorimeterCollection->entries(); i++) {
-    hit = dynamic_cast<dd4hep::sim::Geant4CalorimeterHit*>(m_calorimeterCollection->GetHit(i));
-    if (hit->cellID == id) {
-      hitMatch = hit;
-      hitMatch->energyDeposit += edep;
-      return true;
-    }
+  auto hitIndex = m_hitIndexOfCell.find(id);
+  if (hitIndex != m_hitIndexOfCell.end()) {
+    (*m_calorimeterCollection)[hitIndex->second]->energyDeposit += edep;
+    return true;
   }
   // if not, create a new hit
   // deleted in ~G4Event
-  hitMatch = new dd4hep::sim::Geant4CalorimeterHit(pos);
+  auto hitMatch = new dd4hep::sim::Geant4CalorimeterHit(pos);
   hitMatch->cellID = id;
   hitMatch->energyDeposit = edep;
+  m_hitIndexOfCell.emplace(id, m_calorimeterCollection->entries());
   m_calorimeterCollection->insert(hitMatch);
   return true;
 }
+
+void AggregateCalorimeterSD::EndOfEvent(G4HCofThisEvent*) {
+  if (!m_deferredAggregation || m_deposits.empty()) return;
+  // stable sort keeps the position of the first deposit in each cell, as in the direct aggregation
+  std::stable_sort(m_deposits.begin(), m_deposits.end(),
+                   [](const Deposit& aLhs, const Deposit& aRhs) { return aLhs.cellID < aRhs.cellID; });
+  auto segmentBegin = m_deposits.begin();
+  while (segmentBegin != m_deposits.end()) {
+    auto segmentEnd = std::find_if(segmentBegin, m_deposits.end(), [segmentBegin](const Deposit& aDeposit) {
+      return aDeposit.cellID != segmentBegin->cellID;
+    });
+    // deleted in ~G4Event
+    auto hit = new dd4hep::sim::Geant4CalorimeterHit(segmentBegin->position);
+    hit->cellID = segmentBegin->cellID;
+    hit->energyDeposit = 0;
+    for (auto it = segmentBegin; it != segmentEnd; ++it) {
+      hit->energyDeposit += it->energy;
+    }
+    m_calorimeterCollection->insert(hit);
+    segmentBegin = segmentEnd;
+  }
+  m_deposits.clear();
+}
 }
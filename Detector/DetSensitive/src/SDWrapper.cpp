@@ -19,6 +19,12 @@ static G4VSensitiveDetector* create_simple_tracker_sd(const std::string& aDetect
   return new det::SimpleTrackerSD(
       aDetectorName, readoutName, aLcdd.sensitiveDetector(aDetectorName).readout().segmentation());
 }
+// Factory method to create an instance of SimpleTrackerSD merging consecutive steps in a cell
+static G4VSensitiveDetector* create_coalescing_tracker_sd(const std::string& aDetectorName, dd4hep::Detector& aLcdd) {
+  std::string readoutName = aLcdd.sensitiveDetector(aDetectorName).readout().name();
+  return new det::SimpleTrackerSD(
+      aDetectorName, readoutName, aLcdd.sensitiveDetector(aDetectorName).readout().segmentation(), true);
+}
 // Factory method to create an instance of SimpleCalorimeterSD
 static G4VSensitiveDetector* create_simple_calorimeter_sd(const std::string& aDetectorName,
                                                           dd4hep::Detector& aLcdd) {
@@ -40,6 +46,13 @@ static G4VSensitiveDetector* create_aggregate_calorimeter_sd(const std::string&
   return new det::AggregateCalorimeterSD(
       aDetectorName, readoutName, aLcdd.sensitiveDetector(aDetectorName).readout().segmentation());
 }
+// Factory method to create an instance of AggregateCalorimeterSD aggregating the deposits at the end of event
+static G4VSensitiveDetector* create_deferred_aggregate_calorimeter_sd(const std::string& aDetectorName,
+                                                                      dd4hep::Detector& aLcdd) {
+  std::string readoutName = aLcdd.sensitiveDetector(aDetectorName).readout().name();
+  return new det::AggregateCalorimeterSD(
+      aDetectorName, readoutName, aLcdd.sensitiveDetector(aDetectorName).readout().segmentation(), true);
+}
 // Factory method to create an instance of GflashCalorimeterSD
 static G4VSensitiveDetector* create_gflash_calorimeter_sd(const std::string& aDetectorName,
                                                           dd4hep::Detector& aLcdd) {
@@ -61,14 +74,25 @@ static G4VSensitiveDetector* create_simple_driftchamber(const std::string& aDete
   return new det::SimpleDriftChamber(
       aDetectorName, readoutName, aLcdd.sensitiveDetector(aDetectorName).readout().segmentation());
 }
+// Factory method to create an instance of SimpleDriftChamber merging consecutive steps in a cell
+static G4VSensitiveDetector* create_coalescing_driftchamber(const std::string& aDetectorName,
+                                                            dd4hep::Detector& aLcdd) {
+  std::string readoutName = aLcdd.sensitiveDetector(aDetectorName).readout().name();
+  return new det::SimpleDriftChamber(
+      aDetectorName, readoutName, aLcdd.sensitiveDetector(aDetectorName).readout().segmentation(), true);
+}
 }
 }
 
 DECLARE_EXTERNAL_GEANT4SENSITIVEDETECTOR(SimpleTrackerSD, dd4hep::sim::create_simple_tracker_sd)
+DECLARE_EXTERNAL_GEANT4SENSITIVEDETECTOR(CoalescingTrackerSD, dd4hep::sim::create_coalescing_tracker_sd)
 DECLARE_EXTERNAL_GEANT4SENSITIVEDETECTOR(SimpleCalorimeterSD, dd4hep::sim::create_simple_calorimeter_sd)
 DECLARE_EXTERNAL_GEANT4SENSITIVEDETECTOR(BirksLawCalorimeterSD, dd4hep::sim::create_birks_law_calorimeter_sd)
 DECLARE_EXTERNAL_GEANT4SENSITIVEDETECTOR(AggregateCalorimeterSD, dd4hep::sim::create_aggregate_calorimeter_sd)
+DECLARE_EXTERNAL_GEANT4SENSITIVEDETECTOR(DeferredAggregateCalorimeterSD,
+                                        dd4hep::sim::create_deferred_aggregate_calorimeter_sd)
 DECLARE_EXTERNAL_GEANT4SENSITIVEDETECTOR(GflashCalorimeterSD, dd4hep::sim::create_gflash_calorimeter_sd)
 DECLARE_EXTERNAL_GEANT4SENSITIVEDETECTOR(FullParticleAbsorptionSD, dd4hep::sim::create_full_particle_absorbtion_sd)
 DECLARE_EXTERNAL_GEANT4SENSITIVEDETECTOR(SimpleDriftChamber, dd4hep::sim::create_simple_driftchamber)
+DECLARE_EXTERNAL_GEANT4SENSITIVEDETECTOR(CoalescingDriftChamber, dd4hep::sim::create_coalescing_driftchamber)
 
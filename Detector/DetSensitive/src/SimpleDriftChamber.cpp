@@ -18,8 +18,13 @@
 namespace det {
 SimpleDriftChamber::SimpleDriftChamber(const std::string& aDetectorName,
                                        const std::string& aReadoutName,
-                                       const dd4hep::Segmentation& aSeg)
-    : G4VSensitiveDetector(aDetectorName), m_driftChamberCollection(nullptr), m_seg(aSeg) {
+                                       const dd4hep::Segmentation& aSeg,
+                                       bool aCoalesceSteps)
+    : G4VSensitiveDetector(aDetectorName),
+      m_driftChamberCollection(nullptr),
+      m_seg(aSeg),
+      m_coalesceSteps(aCoalesceSteps),
+      m_lastHit(nullptr) {
   // name of the collection of hits is determined byt the readout name (from XML)
   collectionName.insert(aReadoutName);
 }
@@ -33,6 +38,7 @@ void SimpleDriftChamber::Initialize(G4HCofThisEvent* aHitsCollections) {
       new G4THitsCollection<fcc::Geant4PreDigiTrackHit>(SensitiveDetectorName, collectionName[0]);
   aHitsCollections->AddHitsCollection(G4SDManager::GetSDMpointer()->GetCollectionID(m_driftChamberCollection),
                                       m_driftChamberCollection);
+  m_lastHit = nullptr;
 }
 
 bool SimpleDriftChamber::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
@@ -50,15 +56,25 @@ bool SimpleDriftChamber::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
 
   CLHEP::Hep3Vector prePos = aStep->GetPreStepPoint()->GetPosition();
   CLHEP::Hep3Vector postPos = aStep->GetPostStepPoint()->GetPosition();
+  uint64_t cellID = utils::cellID(m_seg, *aStep);
+
+  // extend the previous hit if this step continues it
+  if (m_coalesceSteps && m_lastHit != nullptr && m_lastHit->trackId == unsigned(track->GetTrackID()) &&
+      m_lastHit->cellID == cellID && m_lastHit->postPos == prePos) {
+    m_lastHit->energyDeposit += edep;
+    m_lastHit->postPos = postPos;
+    return true;
+  }
 
   auto hit = new fcc::Geant4PreDigiTrackHit(
       track->GetTrackID(), track->GetDefinition()->GetPDGEncoding(), edep, track->GetGlobalTime());
 
-  hit->cellID = utils::cellID(m_seg, *aStep);
+  hit->cellID = cellID;
   hit->energyDeposit = edep;
   hit->prePos = prePos;
   hit->postPos = postPos;
   m_driftChamberCollection->insert(hit);
+  m_lastHit = hit;
   return true;
 }
 }
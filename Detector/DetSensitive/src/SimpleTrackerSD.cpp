@@ -18,8 +18,13 @@
 namespace det {
 SimpleTrackerSD::SimpleTrackerSD(const std::string& aDetectorName,
                                  const std::string& aReadoutName,
-                                 const dd4hep::Segmentation& aSeg)
-    : G4VSensitiveDetector(aDetectorName), m_trackerCollection(nullptr), m_seg(aSeg) {
+                                 const dd4hep::Segmentation& aSeg,
+                                 bool aCoalesceSteps)
+    : G4VSensitiveDetector(aDetectorName),
+      m_trackerCollection(nullptr),
+      m_seg(aSeg),
+      m_coalesceSteps(aCoalesceSteps),
+      m_lastHit(nullptr) {
   // name of the collection of hits is determined byt the readout name (from XML)
   collectionName.insert(aReadoutName);
 }
@@ -32,6 +37,7 @@ void SimpleTrackerSD::Initialize(G4HCofThisEvent* aHitsCollections) {
   m_trackerCollection = new G4THitsCollection<fcc::Geant4PreDigiTrackHit>(SensitiveDetectorName, collectionName[0]);
   aHitsCollections->AddHitsCollection(G4SDManager::GetSDMpointer()->GetCollectionID(m_trackerCollection),
                                       m_trackerCollection);
+  m_lastHit = nullptr;
 }
 
 bool SimpleTrackerSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
@@ -42,14 +48,23 @@ bool SimpleTrackerSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
   const G4Track* track = aStep->GetTrack();
   CLHEP::Hep3Vector prePos = aStep->GetPreStepPoint()->GetPosition();
   CLHEP::Hep3Vector postPos = aStep->GetPostStepPoint()->GetPosition();
+  uint64_t cellID = utils::cellID(m_seg, *aStep);
+  // extend the previous hit if this step continues it
+  if (m_coalesceSteps && m_lastHit != nullptr && m_lastHit->trackId == unsigned(track->GetTrackID()) &&
+      m_lastHit->cellID == cellID && m_lastHit->postPos == prePos) {
+    m_lastHit->energyDeposit += edep;
+    m_lastHit->postPos = postPos;
+    return true;
+  }
   // create a hit and add it to collection
   // deleted in ~G4Event
   auto hit = new fcc::Geant4PreDigiTrackHit(
       track->GetTrackID(), track->GetDefinition()->GetPDGEncoding(), edep, track->GetGlobalTime());
-  hit->cellID = utils::cellID(m_seg, *aStep);
+  hit->cellID = cellID;
   hit->prePos = prePos;
   hit->postPos = postPos;
   m_trackerCollection->insert(hit);
+  m_lastHit = hit;
   return true;
 }
 }
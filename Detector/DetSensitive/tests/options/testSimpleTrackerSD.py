@@ -37,6 +37,7 @@ inspecttool = InspectHitsCollectionsTool("inspect", readoutNames=["TrackerSilico
 savetrackertool = SimG4SaveTrackerHits("SimG4SaveTrackerHits", readoutNames = ["TrackerSiliconHits"])
 savetrackertool.positionedTrackHits.Path = "positionedHits"
 savetrackertool.trackHits.Path = "hits"
+savetrackertool.digiTrackHits.Path = "digiHits"
 
 particle_converter = SimG4PrimariesFromEdmTool("EdmConverter")
 particle_converter.genParticles.Path = "allGenParticles"
@@ -0,0 +1,72 @@
+"""Compare the hits of a sensitive detector merging consecutive steps (CoalescingTrackerSD, CoalescingDriftChamber)
+to the hits of the same simulation without merging (SimpleTrackerSD, SimpleDriftChamber).
+
+Consecutive hits of the same track in the same cell, where a step starts at the end of the previous one, have to be
+replaced by a single hit with their summed energy, spanning from the first pre-step to the last post-step position.
+
+Usage: python cmpCoalescedHits.py <file with step hits> <file with coalesced hits>
+"""
+import sys
+from ROOT import gSystem
+from EventStore import EventStore
+
+
+def read_hits(event):
+    """Return the hits as tuples (cellId, trackId, energy, pre-step position, post-step position)"""
+    posHits = event.get('positionedHits')
+    digiHits = event.get('digiHits')
+    assert(len(posHits) == len(digiHits))
+    hits = []
+    for hit, digiHit in zip(posHits, digiHits):
+        pre = (hit.position().x, hit.position().y, hit.position().z)
+        post = (digiHit.postStepPosition().x, digiHit.postStepPosition().y, digiHit.postStepPosition().z)
+        hits.append((hit.core().cellId, hit.core().bits, hit.core().energy, pre, post))
+    return hits
+
+
+def coalesce(hits):
+    """Merge the consecutive hits continuing each other, as expected from the coalescing sensitive detector"""
+    merged = []
+    for cellId, trackId, energy, pre, post in hits:
+        if merged and merged[-1][0] == cellId and merged[-1][1] == trackId and merged[-1][4] == pre:
+            last = merged[-1]
+            merged[-1] = (cellId, trackId, last[2] + energy, last[3], post)
+        else:
+            merged.append((cellId, trackId, energy, pre, post))
+    return merged
+
+
+if __name__ == "__main__":
+    gSystem.Load("libdatamodelDict")
+    stepStore = EventStore([sys.argv[1]])
+    coalescedStore = EventStore([sys.argv[2]])
+    assert(len(stepStore) == len(coalescedStore))
+    numStepHits = 0
+    numCoalescedHits = 0
+    for iev in range(len(stepStore)):
+        stepHits = read_hits(stepStore[iev])
+        coalescedHits = read_hits(coalescedStore[iev])
+        expectedHits = coalesce(stepHits)
+        assert(len(coalescedHits) == len(expectedHits))
+        for hit, expected in zip(coalescedHits, expectedHits):
+            # cell, track and positions are copied, the energy is summed
+            assert(hit[0] == expected[0])
+            assert(hit[1] == expected[1])
+            assert(abs(hit[2] - expected[2]) <= 1e-5 * abs(expected[2]))
+            assert(hit[3] == expected[3])
+            assert(hit[4] == expected[4])
+        # the summed energy of each track in each cell is the same
+        stepEnergy = {}
+        coalescedEnergy = {}
+        for hit in stepHits:
+            stepEnergy[(hit[0], hit[1])] = stepEnergy.get((hit[0], hit[1]), 0) + hit[2]
+        for hit in coalescedHits:
+            coalescedEnergy[(hit[0], hit[1])] = coalescedEnergy.get((hit[0], hit[1]), 0) + hit[2]
+        assert(sorted(stepEnergy.keys()) == sorted(coalescedEnergy.keys()))
+        for key, energy in stepEnergy.items():
+            assert(abs(coalescedEnergy[key] - energy) <= 1e-5 * abs(energy))
+        numStepHits += len(stepHits)
+        numCoalescedHits += len(coalescedHits)
+    print("%d hits merged into %d hits" % (numStepHits, numCoalescedHits))
+    # the electron makes several steps in a cell, some of them have to be merged
+    assert(numCoalescedHits < numStepHits)
@@ -76,17 +76,22 @@ for i, store in enumerate(events):
     StartVertex = fcc.GenVertexData()
     StartVertex.position = svertex.position()
     StartVertex.ctau = svertex.ctau()
-    EndVertex = fcc.GenVertexData()
-    EndVertex.position = evertex.position()
-    EndVertex.ctau = evertex.ctau()
+    # the end vertex is only set for particles with saved secondaries
+    EndVertex = None
+    if evertex.isAvailable():
+      EndVertex = fcc.GenVertexData()
+      EndVertex.position = evertex.position()
+      EndVertex.ctau = evertex.ctau()
     trackId2Vertex[p.bits()] = StartVertex
     if p.status() > 0: # secondary
       secondaryStartVertexVector.push_back(StartVertex)
-      secondaryEndVertexVector.push_back(EndVertex)
+      if EndVertex is not None:
+        secondaryEndVertexVector.push_back(EndVertex)
 
     else: # primary
       primaryStartVertexVector.push_back(StartVertex)
-      primaryEndVertexVector.push_back(EndVertex)
+      if EndVertex is not None:
+        primaryEndVertexVector.push_back(EndVertex)
   trackerhits = store.get("positionedHits")
   for h in trackerhits:
       print "hit trackId: ", h.bits()
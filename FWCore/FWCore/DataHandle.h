@@ -2,6 +2,7 @@
 #define FWCORE_DATAHANDLE_H
 
 #include "FWCore/DataWrapper.h"
+#include "FWCore/PodioDataSvc.h"
 
 #include "GaudiKernel/AlgTool.h"
 #include "GaudiKernel/Algorithm.h"
@@ -24,6 +25,10 @@ public:
   DataHandle(DataObjID& descriptor, Gaudi::DataHandle::Mode a, IDataHandleHolder* fatherAlg);
 
   DataHandle(const std::string& k, Gaudi::DataHandle::Mode a, IDataHandleHolder* fatherAlg);
+
+  /// Releases the recycled wrapper
+  virtual ~DataHandle();
+
   /**
    * Retrieve object from transient data store
    */
@@ -40,9 +45,23 @@ public:
   T* createAndPut();
 
 private:
+  /// Resolve the store slot of the handle (once)
+  void resolveSlot();
+
   ServiceHandle<IDataProviderSvc> m_eds;
   bool m_isGoodType{false};
   bool m_isCollection{false};
+  /// The data service if it is a PodioDataSvc (nullptr otherwise), set by resolveSlot()
+  PodioDataSvc* m_podioDataSvc{nullptr};
+  /// Whether resolveSlot() was called
+  bool m_slotResolved{false};
+  /// Slot of the handle path in the PodioDataSvc
+  int m_slot{-1};
+  /// Object returned by the last get(), valid while the store generation is m_cachedGeneration
+  const T* m_cachedData{nullptr};
+  unsigned long m_cachedGeneration{0};
+  /// Wrapper of the last put(), kept alive with an extra reference so it can be reused once the store released it
+  DataWrapper<T>* m_wrapper{nullptr};
 };
 
 //---------------------------------------------------------------------------
@@ -53,6 +72,20 @@ DataHandle<T>::DataHandle(DataObjID& descriptor, Gaudi::DataHandle::Mode a, IDat
 template <typename T>
 DataHandle<T>::DataHandle(const std::string& descriptor, Gaudi::DataHandle::Mode a, IDataHandleHolder* fatherAlg)
     : DataObjectHandle<DataWrapper<T>>(descriptor, a, fatherAlg), m_eds("EventDataSvc", "DataHandle") {}
+//---------------------------------------------------------------------------
+template <typename T>
+DataHandle<T>::~DataHandle() {
+  if (m_wrapper != nullptr) m_wrapper->release();
+}
+//---------------------------------------------------------------------------
+template <typename T>
+void DataHandle<T>::resolveSlot() {
+  m_slotResolved = true;
+  m_podioDataSvc = dynamic_cast<PodioDataSvc*>(&(*m_eds));
+  if (m_podioDataSvc != nullptr) {
+    m_slot = m_podioDataSvc->slot(DataObjectHandle<DataWrapper<T>>::fullKey().key());
+  }
+}
 
 /**
  * Try to retrieve from the transient store. If the retrieval succeded and
@@ -60,11 +93,23 @@ DataHandle<T>::DataHandle(const std::string& descriptor, Gaudi::DataHandle::Mode
  * object. Then finally set the handle as Read.
  * If this is not the first time we cast and the cast worked, just use the
  * static cast: we do not need the checks of the dynamic cast for every access!
+ * With a PodioDataSvc, the object is looked up once per event and per path (shared by all handles with the same
+ * path) and the result is cached in the handle until the store is cleared.
  */
 template <typename T>
 const T* DataHandle<T>::get() {
+  if (UNLIKELY(!m_slotResolved)) resolveSlot();
   DataObject* dataObjectp = nullptr;
-  auto sc = m_eds->retrieveObject(DataObjectHandle<DataWrapper<T>>::fullKey().key(), dataObjectp);
+  StatusCode sc;
+  if (LIKELY(m_podioDataSvc != nullptr)) {
+    if (m_cachedData != nullptr && m_cachedGeneration == m_podioDataSvc->storeGeneration()) {
+      return m_cachedData;
+    }
+    dataObjectp = m_podioDataSvc->slotObject(m_slot);
+    sc = dataObjectp != nullptr ? StatusCode::SUCCESS : StatusCode::FAILURE;
+  } else {
+    sc = m_eds->retrieveObject(DataObjectHandle<DataWrapper<T>>::fullKey().key(), dataObjectp);
+  }
 
   if (LIKELY(sc.isSuccess())) {
     if (UNLIKELY(!m_isGoodType && !m_isCollection)) {
@@ -79,29 +124,41 @@ const T* DataHandle<T>::get() {
     }
     if (LIKELY(m_isGoodType)) {
       DataObjectHandle<DataWrapper<T>>::setRead();
-      return static_cast<DataWrapper<T>*>(dataObjectp)->getData();
+      m_cachedData = static_cast<DataWrapper<T>*>(dataObjectp)->getData();
     } else if (m_isCollection) {
       // The reader does not know the specific type of the collection. So we need a reinterpret_cast if the handle was
       // created by the reader.
       DataWrapper<podio::CollectionBase>* tmp = static_cast<DataWrapper<podio::CollectionBase>*>(dataObjectp);
       DataObjectHandle<DataWrapper<T>>::setRead();
-      return reinterpret_cast<const T*>(tmp->collectionBase());
+      m_cachedData = reinterpret_cast<const T*>(tmp->collectionBase());
     } else {
       std::string errorMsg("The type provided for " + DataObjectHandle<DataWrapper<T>>::toString() +
                            " is different from the one of the object in the store.");
       throw GaudiException(errorMsg, "wrong product type", StatusCode::FAILURE);
     }
+    if (m_podioDataSvc != nullptr) m_cachedGeneration = m_podioDataSvc->storeGeneration();
+    return m_cachedData;
   }
   std::string msg("Could not retrieve product " + DataObjectHandle<DataWrapper<T>>::toString());
   throw GaudiException(msg, "wrong product name", StatusCode::FAILURE);
 }
 
 //---------------------------------------------------------------------------
+/**
+ * The wrapper is recycled between events: the handle holds a reference to it, so once the store is cleared
+ * the handle is its only owner and it can be registered again with the new object.
+ */
 template <typename T>
 void DataHandle<T>::put(T* objectp) {
-  DataWrapper<T>* dw = new DataWrapper<T>();
-  dw->setData(objectp);
-  DataObjectHandle<DataWrapper<T>>::put(dw);
+  if (m_wrapper != nullptr && m_wrapper->refCount() == 1) {
+    m_wrapper->resetData();
+  } else {
+    if (m_wrapper != nullptr) m_wrapper->release();
+    m_wrapper = new DataWrapper<T>();
+    m_wrapper->addRef();
+  }
+  m_wrapper->setData(objectp);
+  DataObjectHandle<DataWrapper<T>>::put(m_wrapper);
 }
 //---------------------------------------------------------------------------
 /**
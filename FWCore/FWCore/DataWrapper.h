@@ -23,6 +23,11 @@ public:
 
   const T* getData() { return m_data; }
   void setData(T* data) { m_data = data; }
+  /// delete the wrapped object, so that the wrapper can be reused
+  void resetData() {
+    delete m_data;
+    m_data = nullptr;
+  }
   /// try to cast to collectionBase; may return nullptr;
   virtual podio::CollectionBase* collectionBase();
 
@@ -9,6 +9,11 @@
 #include "podio/EventStore.h"
 #include "podio/ROOTReader.h"
 
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <utility>
 // Forward declarations
 
@@ -49,8 +54,47 @@ public:
   void setCollectionIDs(podio::CollectionIDTable* collectionIds);
   /// Resets caches of reader and event store, increases event counter
   void endOfRead();
+  /** Start reading the given collections of the next events in a background thread.
+   *  Does nothing unless read-ahead is enabled (option readAhead) and a file is read.
+   *  Once started, only the given collections can be read with readCollection().
+   *  @param[in] aCollectionIDs IDs of the collections to read
+   *  @return status code
+   */
+  StatusCode startReadAhead(const std::vector<int>& aCollectionIDs);
+
+  /** Slot of a path in the store, used by the data handles to cache their lookup.
+   *  @param[in] aPath path of the object in the store
+   *  @return index of the slot, the same for all calls with the same path
+   */
+  int slot(const std::string& aPath);
+  /** Object at the given slot, retrieved from the store once per event and shared by all handles of the path.
+   *  @param[in] aSlot index of the slot
+   *  @return the object, nullptr if it is not in the store
+   */
+  DataObject* slotObject(int aSlot);
+  /// Incremented in clearStore(), objects cached in an earlier generation are no longer valid
+  unsigned long storeGeneration() const { return m_storeGeneration; }
 
 private:
+  /// Path in the store with the object retrieved in the current event
+  struct Slot {
+    std::string path;
+    DataObject* object;
+    unsigned long generation;
+  };
+  /// Event read in advance by the read-ahead thread
+  struct PrefetchedEvent {
+    /// Store used to read the collections (and to resolve their references)
+    std::unique_ptr<podio::EventStore> store;
+    /// Collections read from the file, in the order of m_readAheadIDs
+    std::vector<podio::CollectionBase*> collections;
+  };
+  /** Loop of the read-ahead thread: reads the events up to the end of file, at most m_readAhead in advance
+   *  @param[in] aFirstEvent number of the first event to read
+   */
+  void readAheadLoop(int aFirstEvent);
+  /// Stop the read-ahead thread and delete the events that were read but not used
+  void stopReadAhead();
   /// PODIO reader for ROOT files
   podio::ROOTReader m_reader;
   /// PODIO EventStore, used to initialise collections
@@ -67,8 +111,34 @@ private:
   std::vector<std::pair<std::string, podio::CollectionBase*>> m_readCollections;
   podio::CollectionIDTable* m_collectionIDs;
 
+  /// Paths of the data handles, see slot()
+  std::vector<Slot> m_slots;
+  /// Counter of the clearStore() calls
+  unsigned long m_storeGeneration{0};
+
+  /// IDs of the collections read by the read-ahead thread
+  std::vector<int> m_readAheadIDs;
+  /// Thread reading the events in advance, owns m_reader once started
+  std::thread m_readAheadThread;
+  /// Events read in advance, ready to be used
+  std::deque<PrefetchedEvent> m_readyEvents;
+  /// Event whose collections are being registered in the store
+  PrefetchedEvent m_currentEvent;
+  /// Protects m_readyEvents and the read-ahead flags
+  std::mutex m_readAheadMutex;
+  /// Notified when an event is read (or the end of file is reached)
+  std::condition_variable m_eventReady;
+  /// Notified when an event is taken from the queue (or the thread is stopped)
+  std::condition_variable m_eventTaken;
+  /// Set when the read-ahead thread reached the end of file
+  bool m_readAheadDone{false};
+  /// Set to stop the read-ahead thread
+  bool m_readAheadStop{false};
+
 protected:
   /// ROOT file name the input is read from. Set by option filename
   std::string m_filename;
+  /// Number of events read in advance in a background thread (0: read in the event loop). Set by option readAhead
+  unsigned int m_readAhead{0};
 };
 #endif  // CORE_PODIODATASVC_H
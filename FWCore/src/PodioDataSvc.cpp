@@ -5,6 +5,10 @@
 
 #include "FWCore/DataWrapper.h"
 
+#include "TROOT.h"
+
+#include <algorithm>
+
 /// Service initialisation
 StatusCode PodioDataSvc::initialize() {
   // Nothing to do: just call base class initialisation
@@ -32,6 +36,7 @@ StatusCode PodioDataSvc::reinitialize() {
 }
 /// Service finalization
 StatusCode PodioDataSvc::finalize() {
+  stopReadAhead();
   m_cnvSvc = 0;  // release
   DataSvc::finalize().ignore();
   return StatusCode::SUCCESS;
@@ -49,13 +54,26 @@ StatusCode PodioDataSvc::clearStore() {
     }
   }
   DataSvc::clearStore().ignore();
+  ++m_storeGeneration;
   m_collections.clear();
   m_readCollections.clear();
   return StatusCode::SUCCESS;
 }
 
 void PodioDataSvc::endOfRead() {
-  if (m_eventMax != -1) {
+  if (m_readAheadThread.joinable()) {
+    // collections are now owned by their data wrappers
+    if (m_currentEvent.store != nullptr) {
+      m_currentEvent.store->clearCaches();
+    }
+    m_currentEvent = PrefetchedEvent();
+    if (++m_eventNum >= m_eventMax) {
+      info() << "Reached end of file with event " << m_eventMax << endmsg;
+      IEventProcessor* eventProcessor;
+      service("ApplicationMgr", eventProcessor);
+      eventProcessor->stopRun();
+    }
+  } else if (m_eventMax != -1) {
     m_provider.clearCaches();
     m_reader.endOfEvent();
     if (m_eventNum++ > m_eventMax) {
@@ -83,7 +101,30 @@ PodioDataSvc::~PodioDataSvc() {}
 
 StatusCode PodioDataSvc::readCollection(const std::string& collName, int collectionID) {
   podio::CollectionBase* collection(nullptr);
-  m_provider.get(collectionID, collection);
+  if (m_readAheadThread.joinable()) {
+    if (m_currentEvent.store == nullptr) {
+      std::unique_lock<std::mutex> lock(m_readAheadMutex);
+      m_eventReady.wait(lock, [this] { return !m_readyEvents.empty() || m_readAheadDone; });
+      if (m_readyEvents.empty()) {
+        error() << "No more events to read from file " << m_filename << endmsg;
+        return StatusCode::FAILURE;
+      }
+      m_currentEvent = std::move(m_readyEvents.front());
+      m_readyEvents.pop_front();
+      lock.unlock();
+      m_eventTaken.notify_one();
+    }
+    auto idIt = std::find(m_readAheadIDs.begin(), m_readAheadIDs.end(), collectionID);
+    if (idIt != m_readAheadIDs.end()) {
+      collection = m_currentEvent.collections[idIt - m_readAheadIDs.begin()];
+    }
+    if (collection == nullptr) {
+      error() << "Collection " << collName << " was not read in advance" << endmsg;
+      return StatusCode::FAILURE;
+    }
+  } else {
+    m_provider.get(collectionID, collection);
+  }
   auto wrapper = new DataWrapper<podio::CollectionBase>;
   int id = m_collectionIDs->add(collName);
   collection->setID(id);
@@ -106,3 +147,95 @@ StatusCode PodioDataSvc::registerObject(const std::string& fullPath, DataObject*
   }
   return DataSvc::registerObject(fullPath, pObject);
 }
+
+int PodioDataSvc::slot(const std::string& aPath) {
+  auto slotIt = std::find_if(m_slots.begin(), m_slots.end(), [&aPath](const Slot& aSlot) { return aSlot.path == aPath; });
+  if (slotIt != m_slots.end()) {
+    return slotIt - m_slots.begin();
+  }
+  m_slots.push_back({aPath, nullptr, 0});
+  return m_slots.size() - 1;
+}
+
+DataObject* PodioDataSvc::slotObject(int aSlot) {
+  Slot& slot = m_slots[aSlot];
+  if (slot.object == nullptr || slot.generation != m_storeGeneration) {
+    if (retrieveObject(slot.path, slot.object).isFailure()) {
+      slot.object = nullptr;
+    }
+    slot.generation = m_storeGeneration;
+  }
+  return slot.object;
+}
+
+StatusCode PodioDataSvc::startReadAhead(const std::vector<int>& aCollectionIDs) {
+  if (m_readAhead == 0 || m_eventMax == -1) {
+    return StatusCode::SUCCESS;
+  }
+  if (m_readAheadThread.joinable()) {
+    error() << "Read-ahead already started, only one reader of the file is supported" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  // the reader is used by the thread from now on, ROOT needs to know about it
+  ROOT::EnableThreadSafety();
+  m_readAheadIDs = aCollectionIDs;
+  m_readAheadDone = false;
+  m_readAheadStop = false;
+  m_readAheadThread = std::thread(&PodioDataSvc::readAheadLoop, this, m_eventNum);
+  debug() << "Reading " << m_readAhead << " events in advance" << endmsg;
+  return StatusCode::SUCCESS;
+}
+
+void PodioDataSvc::readAheadLoop(int aFirstEvent) {
+  for (int eventNum = aFirstEvent; eventNum < m_eventMax; ++eventNum) {
+    {
+      std::unique_lock<std::mutex> lock(m_readAheadMutex);
+      m_eventTaken.wait(lock, [this] { return m_readyEvents.size() < m_readAhead || m_readAheadStop; });
+      if (m_readAheadStop) break;
+    }
+    // each event gets its own store, so that its collections are independent of the event being processed
+    PrefetchedEvent event;
+    event.store.reset(new podio::EventStore());
+    event.store->setReader(&m_reader);
+    m_reader.goToEvent(eventNum);
+    event.collections.reserve(m_readAheadIDs.size());
+    for (auto id : m_readAheadIDs) {
+      podio::CollectionBase* collection(nullptr);
+      event.store->get(id, collection);
+      event.collections.push_back(collection);
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_readAheadMutex);
+      m_readyEvents.push_back(std::move(event));
+    }
+    m_eventReady.notify_one();
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_readAheadMutex);
+    m_readAheadDone = true;
+  }
+  m_eventReady.notify_one();
+}
+
+void PodioDataSvc::stopReadAhead() {
+  if (!m_readAheadThread.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_readAheadMutex);
+    m_readAheadStop = true;
+  }
+  m_eventTaken.notify_one();
+  m_readAheadThread.join();
+  // the collections of events that were not processed were never handed to a data wrapper
+  for (auto& event : m_readyEvents) {
+    for (auto collection : event.collections) {
+      delete collection;
+    }
+    if (event.store != nullptr) {
+      event.store->clearCaches();
+    }
+  }
+  m_readyEvents.clear();
+  m_currentEvent = PrefetchedEvent();
+}
@@ -11,6 +11,8 @@ DECLARE_SERVICE_FACTORY(FCCDataSvc)
 /// Standard Constructor
 FCCDataSvc::FCCDataSvc(const std::string& name, ISvcLocator* svc) : PodioDataSvc(name, svc) {
   declareProperty("input", m_filename = "", "Name of the file to read");
+  declareProperty("readAhead", m_readAhead = 0,
+                  "Number of events read in advance in a background thread (0: no read-ahead)");
 }
 
 /// Standard Destructor
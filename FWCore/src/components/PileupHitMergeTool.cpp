@@ -2,6 +2,8 @@
 
 #include "podio/EventStore.h"
 
+#include <algorithm>
+
 #include "datamodel/CaloHitCollection.h"
 #include "datamodel/PositionedCaloHitCollection.h"
 #include "datamodel/PositionedTrackHitCollection.h"
@@ -82,31 +84,47 @@ StatusCode PileupHitMergeTool<Hits, PositionedHits>::mergeCollections() {
   Hits* collHitsMerged = new Hits();
   PositionedHits* collPosHitsMerged = new PositionedHits();
 
-  unsigned int collectionCounter = 0;
+  // gather the hit payloads into one contiguous buffer
+  size_t numHits = 0;
+  for (auto hitColl : m_hitCollections) {
+    numHits += hitColl->size();
+  }
+  m_hitCores.clear();
+  m_hitCores.reserve(numHits);
+  m_collectionBegins.clear();
+  unsigned int maxBits = 0;
   for (auto hitColl : m_hitCollections) {
-    // copy hits
+    m_collectionBegins.push_back(m_hitCores.size());
     for (const auto elem : *hitColl) {
-
-      auto clon = elem.clone();
-      // add pileup vertex counter with an offset
-      // i.e. for the signal event, 'bits' is just the trackID taken from geant
-      // for the n-th pileup event, 'bits' is the trackID + n * offset
-      // offset needs to be big enough to ensure uniqueness of trackID
-      if (elem.bits() > m_trackIDCollectionOffset) {
-        error() << "Event contains too many tracks to guarantee a unique trackID";
-        error() << " The offset width or trackID field size needs to be adjusted!" << endmsg;
-        return StatusCode::FAILURE;
-      }
-
-      clon.bits(clon.bits() + collectionCounter * m_trackIDCollectionOffset);
-      collHitsMerged->push_back(clon);
+      m_hitCores.push_back(elem.core());
+      maxBits = std::max<unsigned int>(maxBits, elem.bits());
     }
-    ++collectionCounter;
+  }
+  m_collectionBegins.push_back(m_hitCores.size());
+  // offset needs to be big enough to ensure uniqueness of trackID
+  if (maxBits > m_trackIDCollectionOffset) {
+    error() << "Event contains too many tracks to guarantee a unique trackID";
+    error() << " The offset width or trackID field size needs to be adjusted!" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  // add pileup vertex counter with an offset
+  // i.e. for the signal event, 'bits' is just the trackID taken from geant
+  // for the n-th pileup event, 'bits' is the trackID + n * offset
+  for (size_t collectionCounter = 1; collectionCounter + 1 < m_collectionBegins.size(); ++collectionCounter) {
+    const unsigned int offset = collectionCounter * m_trackIDCollectionOffset;
+    fcc::BareHit* cores = m_hitCores.data();
+    for (size_t iHit = m_collectionBegins[collectionCounter]; iHit < m_collectionBegins[collectionCounter + 1];
+         ++iHit) {
+      cores[iHit].bits += offset;
+    }
+  }
+  for (const auto& core : m_hitCores) {
+    collHitsMerged->create(core);
   }
   for (auto posHitColl : m_posHitCollections) {
     // copy positioned hits
     for (const auto elem : *posHitColl) {
-      collPosHitsMerged->push_back(elem.clone());
+      collPosHitsMerged->create(elem.position(), elem.core());
     }
   }
 
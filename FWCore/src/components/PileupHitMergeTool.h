@@ -8,6 +8,9 @@
 #include "FWCore/DataHandle.h"
 #include "FWCore/IEDMMergeTool.h"
 
+// datamodel
+#include "datamodel/BareHit.h"
+
 namespace fcc {
 class HitCollection;
 class PositionedHitCollection;
@@ -18,7 +21,8 @@ class PositionedHitCollection;
  * Implemenation of the MergeTool for *Hits and *PositionedHits, templated to give versions for Tracker / Calorimeter
  * While merging, this algorithm tries to keep the trackIDs unique by adding the pileup event number with an offset.
  * This should be transparent, but the trackIDs will be non-consecutive.
- *
+ * The hit payloads of all collections are first gathered into one contiguous buffer, reserved once per event,
+ * the offsets are then added in a separate pass over the buffer, and the merged collection is created from it.
  *
  */
 
@@ -53,6 +57,10 @@ private:
   std::vector<const Hits*> m_hitCollections;
   /// internal container to keep of collections to be merged
   std::vector<const PositionedHits*> m_posHitCollections;
+  /// Payloads of the hits of all collections, in merging order (kept between events to reuse the allocation)
+  std::vector<fcc::BareHit> m_hitCores;
+  /// Index in m_hitCores of the first hit of each collection, followed by the total number of hits
+  std::vector<size_t> m_collectionBegins;
 
   /// Output of this tool: merged collection
   DataHandle<Hits> m_hitsMerged{"overlay/hits", Gaudi::DataHandle::Writer, this};
@@ -2,8 +2,7 @@
 
 #include "FWCore/IEDMMergeTool.h"
 
-
-
+#include "podio/CollectionIDTable.h"
 
 DECLARE_ALGORITHM_FACTORY(PileupOverlayAlg)
 
@@ -28,15 +27,81 @@ StatusCode PileupOverlayAlg::initialize() {
   }
   m_reader.openFile(m_pileupFilenames[m_pileupFileIndex]);
   m_store.setReader(&m_reader);
+  if (m_minBiasPoolSize > 0 && sc.isSuccess()) {
+    sc = fillMinBiasPool();
+  }
   return sc;
 }
 
+StatusCode PileupOverlayAlg::fillMinBiasPool() {
+  m_minBiasPool.reserve(m_minBiasPoolSize);
+  unsigned int eventIndex = 0;
+  unsigned int nEvents = m_reader.getEntries();
+  unsigned int numFilesRead = 0;
+  while (m_minBiasPool.size() < m_minBiasPoolSize) {
+    if (eventIndex >= nEvents) {
+      // the files are taken in order from the start file, also with doShuffleInputFiles,
+      // so that each file is read at most once
+      if (++numFilesRead >= m_pileupFilenames.size()) {
+        break;
+      }
+      m_pileupFileIndex = (m_pileupFileIndex + 1) % m_pileupFilenames.size();
+      openPileupFile();
+      eventIndex = 0;
+      nEvents = m_reader.getEntries();
+      continue;
+    }
+    m_reader.goToEvent(eventIndex);
+    std::unique_ptr<podio::EventStore> store(new podio::EventStore());
+    store->setReader(&m_reader);
+    // decode all collections of the event while the reader points to it
+    auto idTable = m_reader.getCollectionIDTable();
+    for (const auto& name : idTable->names()) {
+      podio::CollectionBase* collection = nullptr;
+      if (!store->get(idTable->collectionID(name), collection)) {
+        warning() << "No collection could be read from branch " << name << endmsg;
+      }
+    }
+    m_minBiasPool.push_back(std::move(store));
+    ++eventIndex;
+  }
+  if (m_minBiasPool.empty()) {
+    error() << "Minimum bias pool is empty, no events found in pileup files." << endmsg;
+    return StatusCode::FAILURE;
+  }
+  info() << "Read " << m_minBiasPool.size() << " minimum bias events into memory." << endmsg;
+  return StatusCode::SUCCESS;
+}
+
+void PileupOverlayAlg::nextPileupFile() {
+  if (m_doShuffleInputFiles) {
+    m_pileupFileIndex = static_cast<unsigned int>(m_flatDist() * m_pileupFilenames.size());
+  } else {
+    m_pileupFileIndex = (m_pileupFileIndex + 1) % m_pileupFilenames.size();
+  }
+  openPileupFile();
+}
+
+void PileupOverlayAlg::openPileupFile() {
+  m_store.clearCaches();
+  m_reader.closeFile();
+  verbose() << "switching to pileup file " << m_pileupFilenames[m_pileupFileIndex] << endmsg;
+  m_reader.openFile(m_pileupFilenames[m_pileupFileIndex]);
+}
+
 StatusCode PileupOverlayAlg::finalize() {
+  for (auto& store : m_minBiasPool) {
+    store->clearCaches();
+  }
+  m_minBiasPool.clear();
   StatusCode sc = GaudiAlgorithm::finalize();
   return sc;
 }
 
 StatusCode PileupOverlayAlg::execute() {
+  if (!m_minBiasPool.empty()) {
+    return overlayFromPool();
+  }
   unsigned nEvents = m_reader.getEntries();
 
   if (!m_noSignal) {
@@ -66,15 +131,7 @@ StatusCode PileupOverlayAlg::execute() {
     m_minBiasEventIndex = (m_minBiasEventIndex + 1);
     if (m_minBiasEventIndex >= nEvents) {
       m_minBiasEventIndex = 0;
-      if (m_doShuffleInputFiles) {
-        m_pileupFileIndex = static_cast<unsigned int>(m_flatDist() * m_pileupFilenames.size());
-      } else {
-        m_pileupFileIndex = (m_pileupFileIndex + 1) % m_pileupFilenames.size();
-      }
-      m_store.clearCaches();
-      m_reader.closeFile();
-      verbose() << "switching to pileup file " << m_pileupFilenames[m_pileupFileIndex] << endmsg;
-      m_reader.openFile(m_pileupFilenames[m_pileupFileIndex]);
+      nextPileupFile();
       nEvents = m_reader.getEntries();
     }
     m_store.clearCaches();
@@ -86,3 +143,37 @@ StatusCode PileupOverlayAlg::execute() {
 
   return StatusCode::SUCCESS;
 }
+
+StatusCode PileupOverlayAlg::overlayFromPool() {
+  if (!m_noSignal) {
+    for (auto& tool : m_mergeTools) {
+      tool->readSignal();
+    }
+  }
+
+  const unsigned int numPileUp = m_pileUpTool->numberOfPileUp();
+  const unsigned int poolSize = m_minBiasPool.size();
+  for (unsigned iev = 0; iev < numPileUp; ++iev) {
+    // same random skipping as when reading from file, within the pool
+    if (m_randomizePileup == true) {
+      if (m_flatDist() < m_skipProbability) {
+        ++m_minBiasEventIndex;
+      }
+    }
+    if (m_minBiasEventIndex >= poolSize) {
+      m_minBiasEventIndex = 0;
+    }
+    verbose() << "Taking pileup event #" << m_minBiasEventIndex << " from the minimum bias pool ..." << endmsg;
+    // the merge tools copy the collections, so the pool stays unchanged
+    for (auto& tool : m_mergeTools) {
+      tool->readPileupCollection(*m_minBiasPool[m_minBiasEventIndex]);
+    }
+    m_minBiasEventIndex = (m_minBiasEventIndex + 1) % poolSize;
+  }
+
+  for (auto& tool : m_mergeTools) {
+    tool->mergeCollections();
+  }
+
+  return StatusCode::SUCCESS;
+}
@@ -10,6 +10,8 @@
 #include "podio/EventStore.h"
 #include "podio/ROOTReader.h"
 
+#include <memory>
+
 // forward declarations
 class IEDMMergeTool;
 
@@ -22,6 +24,8 @@ class IEDMMergeTool;
  * tools with a very general interface. One thing this algorithm does do is keep track of the
  * number of pileup events (via the pileup tool) and the current position in the minimum bias pool
  * ( which can be randomized by skipping events with a probability that can be set in the options file ).
+ * If minBiasPoolSize is set, that many minimum bias events are read and decoded once at initialize
+ * and kept in memory; pileup events are then taken from this pool instead of being read from disk.
  *
  */
 
@@ -34,6 +38,18 @@ public:
   virtual StatusCode finalize() override final;
 
 private:
+  /** Read the minimum bias pool into memory, each event in its own store.
+   *  Starting at the current (possibly shuffled) file, events are read in order until the pool is full,
+   *  continuing in the following files of the list, so that each file is read at most once.
+   *  All collections of an event are decoded, so the stores are not read from again.
+   */
+  StatusCode fillMinBiasPool();
+  /// Move to the next minimum bias file, shuffled or in order
+  void nextPileupFile();
+  /// Close the current minimum bias file and open the one at m_pileupFileIndex
+  void openPileupFile();
+  /// Overlay the pileup events taken from the in-memory minimum bias pool
+  StatusCode overlayFromPool();
   /// flag to determine whether to randomly skipy events when reading the pileup store
   Gaudi::Property<bool> m_randomizePileup{
       this, "randomizePileup", false,
@@ -59,10 +75,15 @@ private:
   Gaudi::Property<bool> m_doShuffleInputFiles{this, "doShuffleInputFiles", false, "Shuffle list of input files for additional randomization"};
 
   Gaudi::Property<bool> m_noSignal{this, "noSignal", false, "Set to true if you don't want to provide a signal collection"};
+  /// number of minimum bias events kept in memory (0: read every pileup event from file)
+  Gaudi::Property<unsigned int> m_minBiasPoolSize{
+      this, "minBiasPoolSize", 0, "Number of minimum bias events read once and kept in memory (0 to read from file)"};
   /// store for the minimum bias file
   podio::EventStore m_store;
   /// reader for the minimum bias file
   podio::ROOTReader m_reader;
+  /// in-memory minimum bias pool, one store per event holding its decoded collections
+  std::vector<std::unique_ptr<podio::EventStore>> m_minBiasPool;
 
   /// event index within current minimum bias pool
   unsigned int m_minBiasEventIndex;
@@ -26,7 +26,7 @@ StatusCode PodioInput::initialize() {
     }
     m_collectionIDs.push_back(idTable->collectionID(name));
   }
-  return StatusCode::SUCCESS;
+  return m_podioDataSvc->startReadAhead(m_collectionIDs);
 }
 
 StatusCode PodioInput::execute() {
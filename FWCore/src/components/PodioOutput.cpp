@@ -1,13 +1,17 @@
 #include "PodioOutput.h"
 #include "GaudiKernel/IJobOptionsSvc.h"
 #include "FWCore/PodioDataSvc.h"
+#include "TClass.h"
 #include "TFile.h"
+#include "TROOT.h"
 
 DECLARE_COMPONENT(PodioOutput)
 
 PodioOutput::PodioOutput(const std::string& name, ISvcLocator* svcLoc)
     : GaudiAlgorithm(name, svcLoc), m_firstEvent(true) {}
 
+PodioOutput::~PodioOutput() { stopWriterThread(); }
+
 StatusCode PodioOutput::initialize() {
   if (GaudiAlgorithm::initialize().isFailure()) return StatusCode::FAILURE;
 
@@ -20,6 +24,15 @@ StatusCode PodioOutput::initialize() {
   m_datatree = new TTree("events", "Events tree");
   m_metadatatree = new TTree("metadata", "Metadata tree");
   m_switch = KeepDropSwitch(m_outputCommands);
+  if (m_asyncWrite) {
+    if (m_writeQueueSize == 0) {
+      error() << "writeQueueSize needs to be at least 1 for asynchronous writing." << endmsg;
+      return StatusCode::FAILURE;
+    }
+    // the writer thread compresses and writes while other algorithms may use ROOT
+    ROOT::EnableThreadSafety();
+    m_writerThread = std::thread(&PodioOutput::writeQueuedEvents, this);
+  }
   return StatusCode::SUCCESS;
 }
 
@@ -45,28 +58,32 @@ void PodioOutput::resetBranches(const std::vector<std::pair<std::string, podio::
   }
 }
 
+std::string PodioOutput::dataClassName(podio::CollectionBase* collection) const {
+  // TODO: we need the class name in a better way
+  std::string className(typeid(*collection).name());
+  size_t pos = className.find_first_not_of("0123456789");
+  className.erase(0, pos);
+  // demangling the namespace: due to namespace additional characters were introduced:
+  // e.g. N3fcc18TrackHit
+  // remove any number+char before the namespace:
+  pos = className.find_first_of("0123456789");
+  size_t pos1 = className.find_first_not_of("0123456789", pos);
+  className.erase(0, pos1);
+  // replace any numbers between namespace and class with "::"
+  pos = className.find_first_of("0123456789");
+  pos1 = className.find_first_not_of("0123456789", pos);
+  className.replace(pos, pos1 - pos, "::");
+
+  pos = className.find("Collection");
+  className.erase(pos, pos + 10);
+  return "vector<" + className + "Data>";
+}
+
 void PodioOutput::createBranches(const std::vector<std::pair<std::string, podio::CollectionBase*>>& collections,
                                  bool prepare) {
   for (auto& collNamePair : collections) {
     auto collName = collNamePair.first;
-    // TODO: we need the class name in a better way
-    std::string className(typeid(*(collNamePair.second)).name());
-    size_t pos = className.find_first_not_of("0123456789");
-    className.erase(0, pos);
-    // demangling the namespace: due to namespace additional characters were introduced:
-    // e.g. N3fcc18TrackHit
-    // remove any number+char before the namespace:
-    pos = className.find_first_of("0123456789");
-    size_t pos1 = className.find_first_not_of("0123456789", pos);
-    className.erase(0, pos1);
-    // replace any numbers between namespace and class with "::"
-    pos = className.find_first_of("0123456789");
-    pos1 = className.find_first_not_of("0123456789", pos);
-    className.replace(pos, pos1 - pos, "::");
-
-    pos = className.find("Collection");
-    className.erase(pos, pos + 10);
-    std::string collClassName = "vector<" + className + "Data>";
+    std::string collClassName = dataClassName(collNamePair.second);
     int isOn = 0;
     if (m_switch.isOn(collName)) {
       isOn = 1;
@@ -81,15 +98,93 @@ void PodioOutput::createBranches(const std::vector<std::pair<std::string, podio:
         }
       }
     }
-    debug() << isOn << " Registering collection " << collClassName << " " << collName.c_str() << " containing type "
-            << className << endmsg;
+    debug() << isOn << " Registering collection " << collClassName << " " << collName.c_str() << endmsg;
     if (prepare) {
       collNamePair.second->prepareForWrite();
     }
   }
 }
 
+void PodioOutput::detachBuffers(const std::vector<std::pair<std::string, podio::CollectionBase*>>& collections,
+                                bool prepare, std::vector<BranchBuffer>& buffers) {
+  for (auto& collNamePair : collections) {
+    auto collName = collNamePair.first;
+    if (prepare) {
+      collNamePair.second->prepareForWrite();
+    }
+    if (!m_switch.isOn(collName)) continue;
+    // the branches are connected to the address of the buffer pointer, which can be swapped with an empty buffer
+    TClass* dataClass = TClass::GetClass(dataClassName(collNamePair.second).c_str());
+    void** dataAddress = static_cast<void**>(collNamePair.second->getBufferAddress());
+    buffers.push_back({collName, dataClass, *dataAddress});
+    *dataAddress = dataClass->New();
+    auto colls = collNamePair.second->referenceCollections();
+    if (colls != nullptr) {
+      TClass* refClass = TClass::GetClass("vector<podio::ObjectID>");
+      int j = 0;
+      for (auto& c : (*colls)) {
+        buffers.push_back({collName + "#" + std::to_string(j), refClass, c});
+        c = new std::vector<podio::ObjectID>();
+        ++j;
+      }
+    }
+  }
+}
+
+void PodioOutput::writeQueuedEvents() {
+  bool firstEvent = true;
+  while (true) {
+    std::vector<BranchBuffer> buffers;
+    {
+      std::unique_lock<std::mutex> lock(m_writeQueueMutex);
+      m_eventQueued.wait(lock, [this] { return !m_writeQueue.empty() || m_writeQueueClosed; });
+      if (m_writeQueue.empty()) return;
+      buffers = std::move(m_writeQueue.front());
+      m_writeQueue.pop_front();
+    }
+    m_eventTaken.notify_one();
+    // for now assume identical content for every event
+    if (firstEvent) {
+      m_writerBranchAddresses.resize(buffers.size(), nullptr);
+    }
+    for (unsigned int i = 0; i < buffers.size(); ++i) {
+      m_writerBranchAddresses[i] = buffers[i].buffer;
+      if (firstEvent) {
+        m_datatree->Branch(buffers[i].name.c_str(), buffers[i].bufferClass->GetName(), &m_writerBranchAddresses[i]);
+      } else {
+        m_datatree->SetBranchAddress(buffers[i].name.c_str(), &m_writerBranchAddresses[i]);
+      }
+    }
+    firstEvent = false;
+    if (m_datatree->Fill() < 0) {
+      m_writeFailed = true;
+    }
+    for (unsigned int i = 0; i < buffers.size(); ++i) {
+      buffers[i].bufferClass->Destructor(buffers[i].buffer);
+      m_writerBranchAddresses[i] = nullptr;
+    }
+  }
+}
+
 StatusCode PodioOutput::execute() {
+  if (m_asyncWrite) {
+    if (m_writeFailed) {
+      error() << "Writer thread failed to fill the DataTree." << endmsg;
+      return StatusCode::FAILURE;
+    }
+    std::vector<BranchBuffer> buffers;
+    detachBuffers(m_podioDataSvc->getCollections(), true, buffers);
+    detachBuffers(m_podioDataSvc->getReadCollections(), false, buffers);
+    debug() << "Queueing event for DataTree .." << endmsg;
+    {
+      // wait until the writer thread caught up
+      std::unique_lock<std::mutex> lock(m_writeQueueMutex);
+      m_eventTaken.wait(lock, [this] { return m_writeQueue.size() < m_writeQueueSize; });
+      m_writeQueue.push_back(std::move(buffers));
+    }
+    m_eventQueued.notify_one();
+    return StatusCode::SUCCESS;
+  }
   // for now assume identical content for every event
   // register for writing
   if (m_firstEvent) {
@@ -105,7 +200,25 @@ StatusCode PodioOutput::execute() {
   return StatusCode::SUCCESS;
 }
 
+void PodioOutput::stopWriterThread() {
+  if (!m_writerThread.joinable()) return;
+  // write the events left in the queue
+  {
+    std::lock_guard<std::mutex> lock(m_writeQueueMutex);
+    m_writeQueueClosed = true;
+  }
+  m_eventQueued.notify_one();
+  m_writerThread.join();
+}
+
 StatusCode PodioOutput::finalize() {
+  if (m_asyncWrite) {
+    stopWriterThread();
+    if (m_writeFailed) {
+      // the file is still closed properly, but the job fails as events are missing
+      error() << "Writer thread failed to fill the DataTree, the output file is incomplete." << endmsg;
+    }
+  }
   if (GaudiAlgorithm::finalize().isFailure()) return StatusCode::FAILURE;
   // retrieve the configuration of the job
   // and write it to file as vector of strings
@@ -126,5 +239,6 @@ StatusCode PodioOutput::finalize() {
   m_metadatatree->Fill();
   m_file->Write();
   m_file->Close();
+  if (m_writeFailed) return StatusCode::FAILURE;
   return StatusCode::SUCCESS;
 }
@@ -7,9 +7,15 @@
 
 #include "TTree.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 // forward declarations
+class TClass;
 class TFile;
 class PodioDataSvc;
 
@@ -19,6 +25,8 @@ class PodioOutput : public GaudiAlgorithm {
 public:
   /// Constructor.
   PodioOutput(const std::string& name, ISvcLocator* svcLoc);
+  /// Destructor. Stops the writer thread if finalize() was not reached.
+  virtual ~PodioOutput();
 
   /// Initialization of PodioOutput. Acquires the data service, creates trees and root file.
   virtual StatusCode initialize();
@@ -29,8 +37,30 @@ public:
   virtual StatusCode finalize();
 
 private:
+  /// Buffer of one branch, detached from its collection and handed to the writer thread
+  struct BranchBuffer {
+    /// Name of the branch
+    std::string name;
+    /// Class of the buffer, used to create the branch and to delete the buffer after writing
+    TClass* bufferClass;
+    /// The buffer, owned by the writer thread
+    void* buffer;
+  };
   void resetBranches(const std::vector<std::pair<std::string, podio::CollectionBase*>>& collections, bool prepare);
   void createBranches(const std::vector<std::pair<std::string, podio::CollectionBase*>>& collections, bool prepare);
+  /// Name of the class of the data buffer of a collection, e.g. vector<fcc::MCParticleData>
+  std::string dataClassName(podio::CollectionBase* collection) const;
+  /** Detach the buffers of the collections to be written and replace them by empty ones.
+   *  @param[in] collections the collections to write
+   *  @param[in] prepare flag whether the collections need to be prepared for write
+   *  @param[out] buffers the detached buffers
+   */
+  void detachBuffers(const std::vector<std::pair<std::string, podio::CollectionBase*>>& collections, bool prepare,
+                     std::vector<BranchBuffer>& buffers);
+  /// Loop of the writer thread: fills the data tree with the queued events until the queue is closed
+  void writeQueuedEvents();
+  /// Close the write queue and wait until the writer thread wrote the queued events
+  void stopWriterThread();
   /// First event or not
   bool m_firstEvent;
   /// Root file name the output is written to
@@ -38,6 +68,12 @@ private:
   /// Commands which output is to be kept
   Gaudi::Property<std::vector<std::string>> m_outputCommands{
       this, "outputCommands", {"keep *"}, "A set of commands to declare which collections to keep or drop."};
+  /// Flag whether the data tree is filled in a separate writer thread
+  Gaudi::Property<bool> m_asyncWrite{this, "asyncWrite", false,
+                                     "Fill and compress the events in a writer thread while the event loop continues"};
+  /// Maximal number of events queued for the writer thread
+  Gaudi::Property<unsigned int> m_writeQueueSize{this, "writeQueueSize", 4,
+                                                 "Number of events that can be queued before the event loop waits"};
   /// Switch for keeping or dropping outputs
   KeepDropSwitch m_switch;
   /// Needed for collection ID table
@@ -50,6 +86,22 @@ private:
   TTree* m_metadatatree;
   /// The stored collections
   std::vector<podio::CollectionBase*> m_storedCollections;
+  /// The writer thread, the only user of the data tree while it runs
+  std::thread m_writerThread;
+  /// Events waiting to be written
+  std::deque<std::vector<BranchBuffer>> m_writeQueue;
+  /// Protects the write queue and the closed flag
+  std::mutex m_writeQueueMutex;
+  /// Signals the writer thread that an event was queued or that the queue was closed
+  std::condition_variable m_eventQueued;
+  /// Signals the event loop that an event was taken from the queue
+  std::condition_variable m_eventTaken;
+  /// No more events will be queued
+  bool m_writeQueueClosed = false;
+  /// Set by the writer thread if filling the tree failed
+  std::atomic<bool> m_writeFailed{false};
+  /// Branch addresses used by the writer thread, one per branch
+  std::vector<void*> m_writerBranchAddresses;
 };
 
 #endif
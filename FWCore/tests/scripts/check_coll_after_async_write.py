@@ -0,0 +1,19 @@
+from ROOT import gSystem
+from EventStore import EventStore
+
+gSystem.Load("libdatamodelDict")
+store = EventStore(["./pythia_test.root"])
+store_async = EventStore(["./pythia_test_async.root"])
+
+assert(len(store) == len(store_async))
+for iev in range(len(store)):
+    event = store[iev]
+    event_async = store_async[iev]
+
+    for name in ["allGenParticles", "allGenVertices"]:
+        assert(len(event.get(name)) == len(event_async.get(name)))
+
+    for sync, async_written in zip(event.get("allGenParticles"), event_async.get("allGenParticles")):
+        assert(sync.core().p4.px == async_written.core().p4.px)
+        assert(sync.core().p4.py == async_written.core().p4.py)
+        assert(sync.core().p4.pz == async_written.core().p4.pz)
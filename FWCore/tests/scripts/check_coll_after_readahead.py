@@ -0,0 +1,20 @@
+from ROOT import gSystem
+from EventStore import EventStore
+
+gSystem.Load("libdatamodelDict")
+store = EventStore(["./pythia_test.root"])
+store_after = EventStore(["./test_readahead.root"])
+
+# all events read through the prefetch queue are written again
+assert(len(store_after) == min(len(store), 5))
+for iev in range(len(store_after)):
+    event_after = store_after[iev]
+    event = store[iev]
+
+    for name in ["allGenParticles", "allGenVertices"]:
+        assert(len(event.get(name)) == len(event_after.get(name)))
+
+    for before, after in zip(event.get("allGenParticles"), event_after.get("allGenParticles")):
+        assert(before.core().p4.px == after.core().p4.px)
+        assert(before.core().p4.py == after.core().p4.py)
+        assert(before.core().p4.pz == after.core().p4.pz)
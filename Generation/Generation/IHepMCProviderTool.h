@@ -3,9 +3,9 @@
 
 #include "GaudiKernel/IAlgTool.h"
 
-namespace HepMC {
-class GenEvent;
-}
+#include "HepMC/GenEvent.h"
+
+#include <vector>
 
 /**
  *
@@ -15,9 +15,23 @@ class GenEvent;
 
 class IHepMCProviderTool : virtual public IAlgTool {
 public:
-  DeclareInterfaceID(IHepMCProviderTool, 3, 0);
+  DeclareInterfaceID(IHepMCProviderTool, 3, 1);
 
   virtual StatusCode getNextEvent(HepMC::GenEvent&) = 0;
+
+  /** Produce several events at once (e.g. the pileup events of one signal event).
+   *  The default implementation calls getNextEvent() in sequence, providers may generate the events in parallel.
+   *  @param[in] aNumEvents number of events to produce
+   *  @param[out] aEvents vector the events are appended to, in a reproducible order
+   */
+  virtual StatusCode getNextEvents(unsigned int aNumEvents, std::vector<HepMC::GenEvent>& aEvents) {
+    for (unsigned int iEvent = 0; iEvent < aNumEvents; ++iEvent) {
+      aEvents.emplace_back();
+      StatusCode sc = getNextEvent(aEvents.back());
+      if (sc.isFailure()) return sc;
+    }
+    return StatusCode::SUCCESS;
+  }
 };
 
 #endif  // GENERATION_IHEPMCPROVIDERTOOL_H
@@ -0,0 +1,27 @@
+from Gaudi.Configuration import *
+
+from Configurables import FCCDataSvc
+podioevent = FCCDataSvc("EventDataSvc")
+
+# reads the events 5-9 of the binary container, decoded in advance in a background thread
+from Configurables import HepMCFileReader, GenAlg
+readertool = HepMCFileReader("ReaderTool", Filename="hepmc_binary_test.bin", firstEvent=5, readAhead=2)
+reader = GenAlg("Reader", SignalProvider=readertool)
+reader.hepmc.Path = "hepmc"
+
+from Configurables import HepMCDumper
+dumper = HepMCDumper()
+dumper.hepmc.Path = "hepmc"
+
+# the events read back in the text format, compared to the source events by compare_hepmc_binary.py
+from Configurables import HepMCFileWriter
+textwriter = HepMCFileWriter("TextWriter", Filename="hepmc_binary_test_read.dat")
+textwriter.hepmc.Path = "hepmc"
+
+from Configurables import ApplicationMgr
+ApplicationMgr(TopAlg=[reader, dumper, textwriter],
+               EvtSel='NONE',
+               EvtMax=5,
+               ExtSvc=[podioevent],
+               OutputLevel=INFO
+               )
@@ -0,0 +1,25 @@
+from Gaudi.Configuration import *
+
+from Configurables import FCCDataSvc
+podioevent = FCCDataSvc("EventDataSvc")
+
+from Configurables import MomentumRangeParticleGun, GenAlg
+guntool = MomentumRangeParticleGun("SignalProvider", PdgCodes=[-211])
+gun = GenAlg("ParticleGun", SignalProvider=guntool)
+gun.hepmc.Path = "hepmc"
+
+# writes the events to the binary container read by HepMCFileReader
+from Configurables import HepMCFileWriter
+writer = HepMCFileWriter("BinaryWriter", Filename="hepmc_binary_test.bin", Binary=True)
+writer.hepmc.Path = "hepmc"
+# the same events in the text format, compared to the events read back by compare_hepmc_binary.py
+textwriter = HepMCFileWriter("TextWriter", Filename="hepmc_binary_test_source.dat")
+textwriter.hepmc.Path = "hepmc"
+
+from Configurables import ApplicationMgr
+ApplicationMgr(TopAlg=[gun, writer, textwriter],
+               EvtSel='NONE',
+               EvtMax=10,
+               ExtSvc=[podioevent],
+               OutputLevel=INFO
+               )
@@ -0,0 +1,30 @@
+import os
+from Gaudi.Configuration import *
+
+# number of Pythia instances generating the pileup, set by the tests (PythiaPool1Thread, PythiaPool3Threads)
+numThreads = int(os.environ.get("PYTHIA_POOL_THREADS", "1"))
+
+from Configurables import FCCDataSvc
+podioevent = FCCDataSvc("EventDataSvc")
+
+from Configurables import MomentumRangeParticleGun, PythiaInterface, ConstPileUp, HepMCFullMerge, GenAlg
+guntool = MomentumRangeParticleGun("SignalProvider", PdgCodes=[-211])
+pileuptool = PythiaInterface("PileUpProvider", Filename="Generation/data/Pythia_minbias_pp_100TeV.cmd",
+                             numThreads=numThreads, poolSeed=7)
+genpileup = ConstPileUp("Pileup", numPileUpEvents=5)
+gen = GenAlg("Generator", SignalProvider=guntool, PileUpProvider=pileuptool, PileUpTool=genpileup,
+             HepMCMergeTool=HepMCFullMerge())
+gen.hepmc.Path = "hepmc"
+
+# the output must not depend on the number of threads, see compare_pythia_pool.py
+from Configurables import HepMCFileWriter
+writer = HepMCFileWriter("Writer", Filename="pythia_pool_%dthreads.dat" % numThreads)
+writer.hepmc.Path = "hepmc"
+
+from Configurables import ApplicationMgr
+ApplicationMgr(TopAlg=[gen, writer],
+               EvtSel='NONE',
+               EvtMax=3,
+               ExtSvc=[podioevent],
+               OutputLevel=INFO
+               )
@@ -41,14 +41,13 @@ StatusCode GenAlg::execute() {
   }
   m_vertexSmearingTool->smearVertex(*theEvent);
   if (!m_pileUpProvider.empty()) {
-    for (unsigned int i_pileUp = 0; i_pileUp < numPileUp; ++i_pileUp) {
-      auto puEvt = HepMC::GenEvent();
-      sc = m_pileUpProvider->getNextEvent(puEvt);
-      if (StatusCode::SUCCESS != sc) {
-        return sc;
-      }
+    sc = m_pileUpProvider->getNextEvents(numPileUp, eventVector);
+    if (StatusCode::SUCCESS != sc) {
+      return sc;
+    }
+    // smeared in a fixed order, so that the result does not depend on how the provider generated the events
+    for (auto& puEvt : eventVector) {
       m_vertexSmearingTool->smearVertex(puEvt);
-      eventVector.push_back(std::move(puEvt));
     }
   }
   return m_HepMCMergeTool->merge(*theEvent, eventVector);
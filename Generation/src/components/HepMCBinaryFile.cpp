@@ -0,0 +1,202 @@
+#include "HepMCBinaryFile.h"
+
+#include "HepMC/GenEvent.h"
+
+#include <cstring>
+#include <unordered_map>
+
+namespace gen {
+namespace hepmcbinary {
+namespace {
+/// Magic word at the beginning of the file (8 characters, the terminating null is not stored)
+const char* magic() { return "FCCHEPMC"; }
+
+template <typename T>
+void append(std::vector<char>& aBuffer, const T& aRecord) {
+  const char* bytes = reinterpret_cast<const char*>(&aRecord);
+  aBuffer.insert(aBuffer.end(), bytes, bytes + sizeof(T));
+}
+}
+
+bool isBinaryFile(const std::string& aFileName) {
+  std::ifstream file(aFileName, std::ios::binary);
+  char fileMagic[sizeof(FileHeader::magic)];
+  return file.read(fileMagic, sizeof(fileMagic)) && std::memcmp(fileMagic, magic(), sizeof(fileMagic)) == 0;
+}
+}
+
+using namespace hepmcbinary;
+
+bool HepMCBinaryWriter::open(const std::string& aFileName) {
+  m_file.open(aFileName, std::ios::binary | std::ios::trunc);
+  m_offsets.clear();
+  // header is rewritten in close(), once the index is known
+  FileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  return bool(m_file);
+}
+
+bool HepMCBinaryWriter::write(const HepMC::GenEvent& aEvent) {
+  EventRecord record;
+  std::memset(&record, 0, sizeof(record));
+  record.eventNumber = aEvent.event_number();
+  record.signalProcessId = aEvent.signal_process_id();
+  record.mpi = aEvent.mpi();
+  record.momentumUnit = aEvent.momentum_unit();
+  record.lengthUnit = aEvent.length_unit();
+  record.signalVertex = aEvent.signal_process_vertex() ? aEvent.signal_process_vertex()->barcode() : 0;
+  record.beamParticle1 = aEvent.beam_particles().first ? aEvent.beam_particles().first->barcode() : 0;
+  record.beamParticle2 = aEvent.beam_particles().second ? aEvent.beam_particles().second->barcode() : 0;
+  record.scale = aEvent.event_scale();
+  record.alphaQCD = aEvent.alphaQCD();
+  record.alphaQED = aEvent.alphaQED();
+  record.numWeights = aEvent.weights().size();
+  record.numVertices = aEvent.vertices_size();
+  record.numParticles = aEvent.particles_size();
+
+  m_buffer.clear();
+  m_buffer.reserve(sizeof(EventRecord) + record.numWeights * sizeof(double) +
+                   record.numVertices * sizeof(VertexRecord) + record.numParticles * sizeof(ParticleRecord));
+  append(m_buffer, record);
+  for (size_t iWeight = 0; iWeight < record.numWeights; ++iWeight) {
+    append(m_buffer, double(aEvent.weights()[iWeight]));
+  }
+  for (auto vertex = aEvent.vertices_begin(); vertex != aEvent.vertices_end(); ++vertex) {
+    VertexRecord vertexRecord;
+    vertexRecord.barcode = (*vertex)->barcode();
+    vertexRecord.id = (*vertex)->id();
+    vertexRecord.x = (*vertex)->position().x();
+    vertexRecord.y = (*vertex)->position().y();
+    vertexRecord.z = (*vertex)->position().z();
+    vertexRecord.t = (*vertex)->position().t();
+    append(m_buffer, vertexRecord);
+  }
+  for (auto particle = aEvent.particles_begin(); particle != aEvent.particles_end(); ++particle) {
+    ParticleRecord particleRecord;
+    particleRecord.barcode = (*particle)->barcode();
+    particleRecord.pdgId = (*particle)->pdg_id();
+    particleRecord.status = (*particle)->status();
+    particleRecord.productionVertex = (*particle)->production_vertex() ? (*particle)->production_vertex()->barcode() : 0;
+    particleRecord.endVertex = (*particle)->end_vertex() ? (*particle)->end_vertex()->barcode() : 0;
+    particleRecord.reserved = 0;
+    particleRecord.px = (*particle)->momentum().px();
+    particleRecord.py = (*particle)->momentum().py();
+    particleRecord.pz = (*particle)->momentum().pz();
+    particleRecord.e = (*particle)->momentum().e();
+    particleRecord.generatedMass = (*particle)->generated_mass();
+    append(m_buffer, particleRecord);
+  }
+  m_offsets.push_back(m_file.tellp());
+  m_file.write(m_buffer.data(), m_buffer.size());
+  return bool(m_file);
+}
+
+bool HepMCBinaryWriter::close() {
+  if (!m_file.is_open()) return true;
+  FileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, magic(), sizeof(header.magic));
+  header.version = kVersion;
+  header.numEvents = m_offsets.size();
+  header.indexOffset = m_file.tellp();
+  m_file.write(reinterpret_cast<const char*>(m_offsets.data()), m_offsets.size() * sizeof(uint64_t));
+  m_file.seekp(0);
+  m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  bool success = bool(m_file);
+  m_file.close();
+  return success;
+}
+
+bool HepMCBinaryReader::open(const std::string& aFileName, std::string& aError) {
+  m_file.open(aFileName, std::ios::binary);
+  FileHeader header;
+  if (!m_file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+    aError = "cannot read the header of file " + aFileName;
+    return false;
+  }
+  if (std::memcmp(header.magic, magic(), sizeof(header.magic)) != 0 || header.version != kVersion) {
+    aError = "file " + aFileName + " is not a binary HepMC file of version " + std::to_string(kVersion);
+    return false;
+  }
+  m_indexOffset = header.indexOffset;
+  m_offsets.resize(header.numEvents);
+  m_file.seekg(header.indexOffset);
+  if (!m_file.read(reinterpret_cast<char*>(m_offsets.data()), m_offsets.size() * sizeof(uint64_t))) {
+    aError = "cannot read the index of file " + aFileName;
+    return false;
+  }
+  return true;
+}
+
+bool HepMCBinaryReader::read(size_t aIndex, HepMC::GenEvent& aEvent) {
+  if (aIndex >= m_offsets.size()) return false;
+  const uint64_t end = aIndex + 1 < m_offsets.size() ? m_offsets[aIndex + 1] : m_indexOffset;
+  m_buffer.resize(end - m_offsets[aIndex]);
+  m_file.seekg(m_offsets[aIndex]);
+  if (m_buffer.size() < sizeof(EventRecord) || !m_file.read(m_buffer.data(), m_buffer.size())) return false;
+
+  const char* data = m_buffer.data();
+  EventRecord record;
+  std::memcpy(&record, data, sizeof(record));
+  data += sizeof(record);
+  if (m_buffer.size() != sizeof(EventRecord) + record.numWeights * sizeof(double) +
+                             record.numVertices * sizeof(VertexRecord) +
+                             record.numParticles * sizeof(ParticleRecord)) {
+    return false;
+  }
+
+  aEvent.clear();
+  aEvent.set_event_number(record.eventNumber);
+  aEvent.set_signal_process_id(record.signalProcessId);
+  aEvent.set_mpi(record.mpi);
+  aEvent.use_units(HepMC::Units::MomentumUnit(record.momentumUnit), HepMC::Units::LengthUnit(record.lengthUnit));
+  aEvent.set_event_scale(record.scale);
+  aEvent.set_alphaQCD(record.alphaQCD);
+  aEvent.set_alphaQED(record.alphaQED);
+  for (uint32_t iWeight = 0; iWeight < record.numWeights; ++iWeight) {
+    double weight;
+    std::memcpy(&weight, data, sizeof(weight));
+    data += sizeof(weight);
+    aEvent.weights().push_back(weight);
+  }
+
+  std::unordered_map<int, HepMC::GenVertex*> vertices;
+  vertices.reserve(record.numVertices);
+  for (uint32_t iVertex = 0; iVertex < record.numVertices; ++iVertex) {
+    VertexRecord vertexRecord;
+    std::memcpy(&vertexRecord, data, sizeof(vertexRecord));
+    data += sizeof(vertexRecord);
+    auto vertex = new HepMC::GenVertex(
+        HepMC::FourVector(vertexRecord.x, vertexRecord.y, vertexRecord.z, vertexRecord.t), vertexRecord.id);
+    vertex->suggest_barcode(vertexRecord.barcode);
+    aEvent.add_vertex(vertex);
+    vertices.emplace(vertexRecord.barcode, vertex);
+  }
+  for (uint32_t iParticle = 0; iParticle < record.numParticles; ++iParticle) {
+    ParticleRecord particleRecord;
+    std::memcpy(&particleRecord, data, sizeof(particleRecord));
+    data += sizeof(particleRecord);
+    auto productionVertex = vertices.find(particleRecord.productionVertex);
+    auto endVertex = vertices.find(particleRecord.endVertex);
+    // particles only belong to the event through their vertices
+    if (productionVertex == vertices.end() && endVertex == vertices.end()) continue;
+    auto particle = new HepMC::GenParticle(
+        HepMC::FourVector(particleRecord.px, particleRecord.py, particleRecord.pz, particleRecord.e),
+        particleRecord.pdgId, particleRecord.status);
+    particle->suggest_barcode(particleRecord.barcode);
+    particle->set_generated_mass(particleRecord.generatedMass);
+    if (productionVertex != vertices.end()) productionVertex->second->add_particle_out(particle);
+    if (endVertex != vertices.end()) endVertex->second->add_particle_in(particle);
+  }
+
+  if (record.signalVertex != 0) {
+    aEvent.set_signal_process_vertex(aEvent.barcode_to_vertex(record.signalVertex));
+  }
+  if (record.beamParticle1 != 0 && record.beamParticle2 != 0) {
+    aEvent.set_beam_particles(aEvent.barcode_to_particle(record.beamParticle1),
+                              aEvent.barcode_to_particle(record.beamParticle2));
+  }
+  return true;
+}
+}
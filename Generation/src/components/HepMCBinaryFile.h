@@ -0,0 +1,130 @@
+#ifndef GENERATION_HEPMCBINARYFILE_H
+#define GENERATION_HEPMCBINARYFILE_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace HepMC {
+class GenEvent;
+}
+
+/** @file HepMCBinaryFile.h Generation/src/components/HepMCBinaryFile.h HepMCBinaryFile.h
+ *
+ *  Compact binary container of HepMC events, written by HepMCFileWriter (option Binary) and read by HepMCFileReader.
+ *  Layout (native byte order):
+ *   - FileHeader (magic, version, number of events, offset of the index),
+ *   - event records: EventRecord, weights, VertexRecord [numVertices], ParticleRecord [numParticles],
+ *   - index: offset of each event record [numEvents].
+ *  Vertices and particles are stored as fixed-size records, so that an event is read with a single read and decoded
+ *  without any text parsing; the index gives random access to any event.
+ *  Only the event content used in FCCSW is stored: PDF, heavy ion, flow and polarization information is dropped.
+ */
+
+namespace gen {
+namespace hepmcbinary {
+/// File header
+struct FileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t numEvents;
+  uint64_t indexOffset;
+};
+/// Event header record
+struct EventRecord {
+  int32_t eventNumber;
+  int32_t signalProcessId;
+  int32_t mpi;
+  int32_t momentumUnit;
+  int32_t lengthUnit;
+  int32_t signalVertex;
+  int32_t beamParticle1;
+  int32_t beamParticle2;
+  double scale;
+  double alphaQCD;
+  double alphaQED;
+  uint32_t numWeights;
+  uint32_t numVertices;
+  uint32_t numParticles;
+  uint32_t reserved;
+};
+/// Vertex record
+struct VertexRecord {
+  int32_t barcode;
+  int32_t id;
+  double x, y, z, t;
+};
+/// Particle record, vertices are referred to by their barcode (0 if none)
+struct ParticleRecord {
+  int32_t barcode;
+  int32_t pdgId;
+  int32_t status;
+  int32_t productionVertex;
+  int32_t endVertex;
+  int32_t reserved;
+  double px, py, pz, e;
+  double generatedMass;
+};
+/// Current version of the format
+const uint32_t kVersion = 1;
+/// Check whether the file starts with the magic word of the binary format
+bool isBinaryFile(const std::string& aFileName);
+}
+
+/** @class HepMCBinaryWriter
+ *
+ *  Writes events to a binary HepMC container, the index is written in close().
+ */
+class HepMCBinaryWriter {
+public:
+  ~HepMCBinaryWriter() { close(); }
+  /// Create the file, return false on failure
+  bool open(const std::string& aFileName);
+  /// Append an event to the file
+  bool write(const HepMC::GenEvent& aEvent);
+  /// Write the index and close the file
+  bool close();
+
+private:
+  std::ofstream m_file;
+  /// Offsets of the written events
+  std::vector<uint64_t> m_offsets;
+  /// Scratch buffer of the encoded event
+  std::vector<char> m_buffer;
+};
+
+/** @class HepMCBinaryReader
+ *
+ *  Random access reader of a binary HepMC container.
+ */
+class HepMCBinaryReader {
+public:
+  /** Open the file and read its index.
+   *  @param[in] aFileName name of the file
+   *  @param[out] aError reason of the failure
+   *  @return true on success
+   */
+  bool open(const std::string& aFileName, std::string& aError);
+  /// Number of events in the file
+  size_t size() const { return m_offsets.size(); }
+  /** Read an event.
+   *  @param[in] aIndex number of the event in the file
+   *  @param[out] aEvent the event, any previous content is removed
+   *  @return true on success
+   */
+  bool read(size_t aIndex, HepMC::GenEvent& aEvent);
+
+private:
+  std::ifstream m_file;
+  /// Offsets of the events
+  std::vector<uint64_t> m_offsets;
+  /// Offset of the index, end of the last event
+  uint64_t m_indexOffset = 0;
+  /// Scratch buffer of the encoded event
+  std::vector<char> m_buffer;
+};
+}
+
+#endif /* GENERATION_HEPMCBINARYFILE_H */
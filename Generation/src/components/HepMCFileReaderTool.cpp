@@ -17,10 +17,25 @@ HepMCFileReader::HepMCFileReader(const std::string& type, const std::string& nam
 HepMCFileReader::~HepMCFileReader() { ; }
 
 StatusCode HepMCFileReader::initialize() {
+  StatusCode sc = GaudiTool::initialize();
+  if (sc.isFailure()) return sc;
   if (m_filename.empty()) {
     error() << "Input file name is not specified!" << endmsg;
     return StatusCode::FAILURE;
   }
+  if (gen::hepmcbinary::isBinaryFile(m_filename)) {
+    m_binaryFile = std::make_unique<gen::HepMCBinaryReader>();
+    std::string errorString;
+    if (!m_binaryFile->open(m_filename, errorString)) {
+      error() << "Failure to read the file '" + m_filename + "': " << errorString << endmsg;
+      return StatusCode::FAILURE;
+    }
+    m_nextEvent = m_firstEvent;
+    if (m_readAhead > 0) {
+      m_readAheadThread = std::thread(&HepMCFileReader::readAheadLoop, this);
+    }
+    return sc;
+  }
   // open file using HepMC routines
   m_file = std::make_unique<HepMC::IO_GenEvent>(m_filename.value().c_str(), std::ios::in);
   // check that readable
@@ -28,12 +43,46 @@ StatusCode HepMCFileReader::initialize() {
     error() << "Failure to read the file '" + m_filename + "'" << endmsg;
     return StatusCode::FAILURE;
   }
-  return StatusCode::SUCCESS;
-  StatusCode sc = GaudiTool::initialize();
+  // the text format has no index: skip the first events by parsing them
+  HepMC::GenEvent skippedEvent;
+  for (unsigned int iEvent = 0; iEvent < m_firstEvent; ++iEvent) {
+    if (!m_file->fill_next_event(&skippedEvent)) {
+      error() << "File '" + m_filename + "' has less than " << m_firstEvent << " events" << endmsg;
+      return StatusCode::FAILURE;
+    }
+  }
   return sc;
 }
 
 StatusCode HepMCFileReader::getNextEvent(HepMC::GenEvent& event) {
+  if (m_binaryFile != nullptr) {
+    bool success = false;
+    if (m_readAheadThread.joinable()) {
+      std::unique_lock<std::mutex> lock(m_readAheadMutex);
+      m_eventReady.wait(lock, [this] { return !m_readyEvents.empty() || m_readAheadDone; });
+      if (!m_readyEvents.empty()) {
+        event.swap(*m_readyEvents.front());
+        m_readyEvents.pop_front();
+        success = true;
+      } else if (m_readAheadFailed) {
+        error() << "Error reading HepMC file" << endmsg;
+        return StatusCode::FAILURE;
+      }
+      lock.unlock();
+      m_eventTaken.notify_one();
+    } else if (m_nextEvent < m_binaryFile->size()) {
+      if (!m_binaryFile->read(m_nextEvent++, event)) {
+        error() << "Error reading HepMC file" << endmsg;
+        return StatusCode::FAILURE;
+      }
+      success = true;
+    }
+    if (!success) {
+      error() << "Premature end of file: Please set the number of events according to hepMC file." << endmsg;
+      return Error("Reached end of file before finished processing");
+    }
+    return StatusCode::SUCCESS;
+  }
   if (!m_file->fill_next_event(&event)) {
     if (m_file->rdstate() == std::ios::eofbit) {
       error() << "Error reading HepMC file" << endmsg;
@@ -45,7 +94,43 @@ StatusCode HepMCFileReader::getNextEvent(HepMC::GenEvent& event) {
   return StatusCode::SUCCESS;
 }
 
+void HepMCFileReader::readAheadLoop() {
+  for (size_t iEvent = m_nextEvent; iEvent < m_binaryFile->size(); ++iEvent) {
+    {
+      std::unique_lock<std::mutex> lock(m_readAheadMutex);
+      m_eventTaken.wait(lock, [this] { return m_readyEvents.size() < m_readAhead || m_readAheadStop; });
+      if (m_readAheadStop) break;
+    }
+    std::unique_ptr<HepMC::GenEvent> event(new HepMC::GenEvent());
+    bool success = m_binaryFile->read(iEvent, *event);
+    {
+      std::lock_guard<std::mutex> lock(m_readAheadMutex);
+      if (!success) {
+        m_readAheadFailed = true;
+        break;
+      }
+      m_readyEvents.push_back(std::move(event));
+    }
+    m_eventReady.notify_one();
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_readAheadMutex);
+    m_readAheadDone = true;
+  }
+  m_eventReady.notify_one();
+}
+
 StatusCode HepMCFileReader::finalize() {
+  if (m_readAheadThread.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(m_readAheadMutex);
+      m_readAheadStop = true;
+    }
+    m_eventTaken.notify_one();
+    m_readAheadThread.join();
+    m_readyEvents.clear();
+  }
+  m_binaryFile.reset();
   m_file.reset();
   return GaudiTool::finalize();
 }
@@ -8,6 +8,22 @@
 #include "HepMC/GenEvent.h"
 #include "HepMC/IO_GenEvent.h"
 
+#include "HepMCBinaryFile.h"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/** @class HepMCFileReader Generation/src/components/HepMCFileReaderTool.h HepMCFileReaderTool.h
+ *
+ *  Reads events from a HepMC file, either in the text IO_GenEvent format or in the binary container written by
+ *  HepMCFileWriter (detected from the file content).
+ *  Binary files give random access: reading starts directly at event firstEvent (e.g. to split a sample between jobs),
+ *  and the events can be decoded in advance in a background thread (readAhead).
+ */
+
 class HepMCFileReader : public GaudiTool, virtual public IHepMCProviderTool {
 public:
   HepMCFileReader(const std::string& type, const std::string& name, const IInterface* parent);
@@ -23,8 +39,33 @@ public:
 
 private:
   void close();
+  /// Loop of the read-ahead thread: decodes the events of the binary file, at most m_readAhead in advance
+  void readAheadLoop();
   Gaudi::Property<std::string> m_filename{this, "Filename", "", "Name of the HepMC file to read"};
+  Gaudi::Property<unsigned int> m_firstEvent{this, "firstEvent", 0, "Number of the first event to read"};
+  Gaudi::Property<unsigned int> m_readAhead{
+      this, "readAhead", 0, "Number of events decoded in advance in a background thread (binary files only)"};
   std::unique_ptr<HepMC::IO_GenEvent> m_file;
+  /// Reader of binary files
+  std::unique_ptr<gen::HepMCBinaryReader> m_binaryFile;
+  /// Number of the next event to read from the binary file
+  size_t m_nextEvent{0};
+  /// Thread decoding the events in advance, owns m_binaryFile once started
+  std::thread m_readAheadThread;
+  /// Events decoded in advance
+  std::deque<std::unique_ptr<HepMC::GenEvent>> m_readyEvents;
+  /// Protects m_readyEvents and the read-ahead flags
+  std::mutex m_readAheadMutex;
+  /// Notified when an event is decoded (or the thread is done)
+  std::condition_variable m_eventReady;
+  /// Notified when an event is taken from the queue (or the thread is stopped)
+  std::condition_variable m_eventTaken;
+  /// Set when the read-ahead thread is done (end of file or error)
+  bool m_readAheadDone{false};
+  /// Set if an event could not be read
+  bool m_readAheadFailed{false};
+  /// Set to stop the read-ahead thread
+  bool m_readAheadStop{false};
 };
 
 #endif  // GENERATION_HEPMCFILEREADER_H
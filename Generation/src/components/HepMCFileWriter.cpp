@@ -10,6 +10,14 @@ HepMCFileWriter::HepMCFileWriter(const std::string& name, ISvcLocator* svcLoc) :
 
 StatusCode HepMCFileWriter::initialize() {
 
+  if (m_binary) {
+    m_binaryFile = std::make_unique<gen::HepMCBinaryWriter>();
+    if (!m_binaryFile->open(m_filename)) {
+      error() << "Failure to write the file '" + m_filename + "'" << endmsg;
+      return StatusCode::FAILURE;
+    }
+    return GaudiAlgorithm::initialize();
+  }
   m_file = std::make_unique<HepMC::IO_GenEvent>(m_filename.value().c_str(), std::ios::out);
   // check that readable
   if ((nullptr == m_file) || (m_file->rdstate() == std::ios::failbit)) {
@@ -21,11 +29,26 @@ StatusCode HepMCFileWriter::initialize() {
 
 StatusCode HepMCFileWriter::execute() {
   const HepMC::GenEvent* theEvent = m_hepmchandle.get();
+  if (m_binaryFile != nullptr) {
+    if (!m_binaryFile->write(*theEvent)) {
+      error() << "Failure to write the event to file '" + m_filename + "'" << endmsg;
+      return StatusCode::FAILURE;
+    }
+    return StatusCode::SUCCESS;
+  }
   m_file->write_event(theEvent);
   return StatusCode::SUCCESS;
 }
 
 StatusCode HepMCFileWriter::finalize() {
+  // without its index the binary file cannot be read
+  bool closed = m_binaryFile == nullptr || m_binaryFile->close();
+  if (!closed) {
+    error() << "Failure to write the index of file '" + m_filename + "'" << endmsg;
+  }
+  m_binaryFile.reset();
   m_file.reset();
-  return GaudiAlgorithm::finalize();
+  StatusCode sc = GaudiAlgorithm::finalize();
+  if (!closed) return StatusCode::FAILURE;
+  return sc;
 }
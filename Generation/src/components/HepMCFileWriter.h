@@ -5,6 +5,8 @@
 
 #include "FWCore/DataHandle.h"
 
+#include "HepMCBinaryFile.h"
+
 namespace HepMC {
 class GenEvent;
 class IO_GenEvent;
@@ -18,6 +20,8 @@ class IO_GenEvent;
  * The HepMC format is text-based, fairly verbose and more suitable
  * for debugging than actual storage of physics result, which should be
  * done in the fccsw event data format.
+ * With the option Binary, the events are written to the compact binary container read by HepMCFileReader,
+ * e.g. to convert a text file once (HepMCFileReader -> GenAlg -> HepMCFileWriter) before using it as pileup input.
  */
 
 class HepMCFileWriter : public GaudiAlgorithm {
@@ -37,7 +41,10 @@ private:
   /// Handle for the HepMC to be read
   DataHandle<HepMC::GenEvent> m_hepmchandle{"HepMC", Gaudi::DataHandle::Reader, this};
   Gaudi::Property<std::string> m_filename{this, "Filename", "Output_HepMC.dat", "Name of the HepMC file to write"};
+  Gaudi::Property<bool> m_binary{this, "Binary", false, "Write the binary container instead of the text format"};
   std::unique_ptr<HepMC::IO_GenEvent> m_file;
+  /// Writer of the binary container
+  std::unique_ptr<gen::HepMCBinaryWriter> m_binaryFile;
 };
 
 #endif  // GENERATION_HEPMCFILEWRITER_H
@@ -2,7 +2,9 @@
 
 // Gaudi
 #include "GaudiKernel/IIncidentSvc.h"
+#include "GaudiKernel/IProperty.h"
 #include "GaudiKernel/Incident.h"
+#include "GaudiKernel/PhysicalConstants.h"
 #include "GaudiKernel/System.h"
 
 // Pythia
@@ -21,9 +23,15 @@
 
 // FCC EDM
 #include "datamodel/FloatValueCollection.h"
+#include "datamodel/GenVertexCollection.h"
+#include "datamodel/MCParticleCollection.h"
 
 #include "HepMC/GenEvent.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+
 DECLARE_TOOL_FACTORY(PythiaInterface)
 
 PythiaInterface::PythiaInterface(const std::string& type, const std::string& name, const IInterface* parent)
@@ -39,6 +47,8 @@ PythiaInterface::PythiaInterface(const std::string& type, const std::string& nam
 
   declareProperty("VertexSmearingTool", m_vertexSmearingTool);
   declareTool(m_vertexSmearingTool, "FlatSmearVertex/VertexSmearingTool");
+  declareProperty("genparticles", m_genphandle, "Generated particles collection (output, if saveEDM)");
+  declareProperty("genvertices", m_genvhandle, "Generated vertices collection (output, if saveEDM)");
 }
 
 StatusCode PythiaInterface::initialize() {
@@ -112,15 +122,114 @@ StatusCode PythiaInterface::initialize() {
 
   m_pythiaSignal->init();
 
+  m_toHepMC = std::unique_ptr<HepMC::Pythia8ToHepMC>(new HepMC::Pythia8ToHepMC());
+  // status filter as a lookup table; empty list keeps all particles
+  m_keepStatus.clear();
+  for (auto status : m_edmStatusList) {
+    if (status >= m_keepStatus.size()) m_keepStatus.resize(status + 1, false);
+    m_keepStatus[status] = true;
+  }
+
+  if (m_saveEDM) {
+    // the collections are written once per event: only for the signal, not for the pileup events
+    SmartIF<IProperty> parentProperties(const_cast<IInterface*>(parent()));
+    const std::string localName = name().substr(name().rfind('.') + 1);
+    if (parentProperties && parentProperties->hasProperty("PileUpProvider")) {
+      const std::string pileUpProvider = parentProperties->getProperty("PileUpProvider").toString();
+      if (pileUpProvider.substr(pileUpProvider.rfind('/') + 1) == localName) {
+        return Error("saveEDM is only available for the signal provider, not for the pileup provider!");
+      }
+    }
+    if (m_numThreads > 0) {
+      return Error("saveEDM is not available with the parallel generation (numThreads > 0)!");
+    }
+  }
+
+  // Pool of independent instances for the parallel generation, reseeded for each event
+  if (m_numThreads > 0) {
+    if (!m_saveHepMC) {
+      return Error("The parallel generation always fills HepMC events, saveHepMC cannot be switched off!");
+    }
+    if (m_doMePsMatching || m_doMePsMerging) {
+      return Error("Parallel generation is not supported with ME/PS matching or merging!");
+    }
+    // every instance would read the same LHE file from its beginning and replay the same events
+    if (m_pythiaSignal->settings.mode("Beams:frameType") == 4) {
+      return Error("Parallel generation is not supported with LHEF input (Beams:frameType = 4)!");
+    }
+    for (unsigned int iThread = 0; iThread < m_numThreads; ++iThread) {
+      std::unique_ptr<Pythia8::Pythia> pythia(new Pythia8::Pythia(xmlpath, false));
+      pythia->readFile(m_parfile.value().c_str());
+      pythia->readString("Random:setSeed = on");
+      pythia->readString("Print:quiet = on");
+      if (!pythia->init()) {
+        return Error("Failed to initialise the Pythia instances of the pool!");
+      }
+      m_pythiaPool.push_back(std::move(pythia));
+    }
+    info() << "Generating events in parallel with " << m_numThreads << " Pythia instances" << endmsg;
+  }
+
   // Return the status code
   return sc;
 }
 
-StatusCode PythiaInterface::getNextEvent(HepMC::GenEvent& theEvent) {
+StatusCode PythiaInterface::getNextEvents(unsigned int aNumEvents, std::vector<HepMC::GenEvent>& aEvents) {
+  if (m_pythiaPool.empty()) {
+    return IHepMCProviderTool::getNextEvents(aNumEvents, aEvents);
+  }
+  const size_t first = aEvents.size();
+  aEvents.resize(first + aNumEvents);
+  // one thread per instance, each generating a fixed subset of the events
+  std::vector<char> success(m_pythiaPool.size(), false);
+  std::vector<std::thread> workers;
+  for (unsigned int iWorker = 1; iWorker < m_pythiaPool.size(); ++iWorker) {
+    workers.emplace_back([this, iWorker, &aEvents, first, &success] {
+      success[iWorker] = generateInPool(iWorker, aEvents, first);
+    });
+  }
+  success[0] = generateInPool(0, aEvents, first);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  m_iPoolCall++;
+  if (std::find(success.begin(), success.end(), false) != success.end()) {
+    IIncidentSvc* incidentSvc;
+    service("IncidentSvc", incidentSvc);
+    incidentSvc->fireIncident(Incident(name(), IncidentType::AbortEvent));
+    return Error("Event generation aborted prematurely, owing to error!");
+  }
+  return StatusCode::SUCCESS;
+}
+
+bool PythiaInterface::generateInPool(unsigned int aWorker, std::vector<HepMC::GenEvent>& aEvents, size_t aFirst) {
+  Pythia8::Pythia& pythia = *m_pythiaPool[aWorker];
+  HepMC::Pythia8ToHepMC toHepMC;
+  for (size_t iEvent = aFirst + aWorker; iEvent < aEvents.size(); iEvent += m_pythiaPool.size()) {
+    pythia.rndm.init(poolSeed(m_iPoolCall, iEvent - aFirst));
+    // Quit if many failures in a row
+    int nAbort = 0;
+    while (!pythia.next()) {
+      if (++nAbort > m_nAbort) {
+        return false;
+      }
+    }
+    toHepMC.fill_next_event(pythia, &aEvents[iEvent], iEvent - aFirst);
+  }
+  return true;
+}
 
-  // Interface for conversion from Pythia8::Event to HepMC event.
-  HepMC::Pythia8ToHepMC* toHepMC = new HepMC::Pythia8ToHepMC();
-  Pythia8::Event sumEvent;
+int PythiaInterface::poolSeed(unsigned int aCall, unsigned int aIndex) const {
+  // splitmix64 finalizer of the (seed, call, index) triplet, mapped to the valid range of Pythia8::Rndm seeds
+  uint64_t seed = (uint64_t(uint32_t(m_poolSeed)) << 32) ^ (uint64_t(aCall) << 20) ^ aIndex;
+  seed += 0x9e3779b97f4a7c15ULL;
+  seed = (seed ^ (seed >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  seed = (seed ^ (seed >> 27)) * 0x94d049bb133111ebULL;
+  seed ^= seed >> 31;
+  return 1 + seed % 900000000;
+}
+
+StatusCode PythiaInterface::getNextEvent(HepMC::GenEvent& theEvent) {
 
   // Generate events. Quit if many failures in a row
   while (!m_pythiaSignal->next()) {
@@ -229,8 +338,16 @@ StatusCode PythiaInterface::getNextEvent(HepMC::GenEvent& theEvent) {
     }
   }  // Debug
 
+  if (m_saveEDM) {
+    fillEDM(m_pythiaSignal->event);
+  }
+  if (!m_saveHepMC) {
+    m_iEvent++;
+    return StatusCode::SUCCESS;
+  }
+
   // Define HepMC event and convert Pythia event into this HepMC event type
-  toHepMC->fill_next_event(*m_pythiaSignal, &theEvent, m_iEvent);
+  m_toHepMC->fill_next_event(*m_pythiaSignal, &theEvent, m_iEvent);
 
   // Print debug: HepMC event info
   if (msgLevel() <= MSG::DEBUG) {
@@ -276,12 +393,74 @@ StatusCode PythiaInterface::getNextEvent(HepMC::GenEvent& theEvent) {
   // Handle event via standard Gaudi mechanism
   m_iEvent++;
 
-  delete toHepMC;
   return StatusCode::SUCCESS;
 }
 
+void PythiaInterface::fillEDM(const Pythia8::Event& aEvent) {
+  fcc::MCParticleCollection* particles = new fcc::MCParticleCollection();
+  fcc::GenVertexCollection* vertices = new fcc::GenVertexCollection();
+  // Pythia works in GeV and mm, as the HepMC events it fills
+  const double lengthFactor =
+      HepMC::Units::conversion_factor(HepMC::Units::MM, gen::hepmcdefault::length) * gen::hepmc2edm::length;
+  const double energyFactor =
+      HepMC::Units::conversion_factor(HepMC::Units::GEV, gen::hepmcdefault::energy) * gen::hepmc2edm::energy;
+
+  // vertex shared by the daughters of particle i (the end vertex of the mothers), created on first use
+  m_sharedVertices.assign(aEvent.size(), fcc::GenVertex(nullptr));
+  auto createVertex = [&](const Pythia8::Particle& aOutgoing) {
+    auto vertex = vertices->create();
+    auto& position = vertex.position();
+    position.x = aOutgoing.xProd() * lengthFactor;
+    position.y = aOutgoing.yProd() * lengthFactor;
+    position.z = aOutgoing.zProd() * lengthFactor;
+    vertex.ctau(aOutgoing.tProd() * Gaudi::Units::c_light * lengthFactor);
+    return vertex;
+  };
+  auto sharedVertex = [&](int aMother, const Pythia8::Particle& aOutgoing) {
+    if (!m_sharedVertices[aMother].isAvailable()) m_sharedVertices[aMother] = createVertex(aOutgoing);
+    return m_sharedVertices[aMother];
+  };
+  auto firstMother = [&aEvent](int aIndex) {
+    return aEvent[aIndex].mother1() > 0 ? aEvent[aIndex].mother1() : aEvent[aIndex].mother2();
+  };
+
+  // particle 0 is the event record system, not a physical particle
+  for (int i = 1; i < aEvent.size(); ++i) {
+    const Pythia8::Particle& pythiaParticle = aEvent[i];
+    const int status = pythiaParticle.statusHepMC();
+    if (!m_keepStatus.empty() && (status < 0 || size_t(status) >= m_keepStatus.size() || !m_keepStatus[status])) {
+      continue;
+    }
+    fcc::MCParticle particle = particles->create();
+    particle.pdgId(pythiaParticle.id());
+    particle.status(status);
+    particle.charge(pythiaParticle.charge());
+    auto& p4 = particle.p4();
+    p4.px = pythiaParticle.px() * energyFactor;
+    p4.py = pythiaParticle.py() * energyFactor;
+    p4.pz = pythiaParticle.pz() * energyFactor;
+    p4.mass = pythiaParticle.m() * energyFactor;
+
+    // production vertex: the end vertex of the mothers, or a vertex of its own for particles without mother
+    const int mother = firstMother(i);
+    particle.startVertex(mother > 0 ? sharedVertex(mother, pythiaParticle) : createVertex(pythiaParticle));
+    // decay vertex: the production vertex of the daughters
+    const int daughter = pythiaParticle.daughter1();
+    if (daughter > 0) {
+      const int daughterMother = firstMother(daughter);
+      particle.endVertex(sharedVertex(daughterMother > 0 ? daughterMother : i, aEvent[daughter]));
+    }
+  }
+
+  // the handles refer to objects of this event's collection, freed when the store is cleared
+  m_sharedVertices.clear();
+  m_genphandle.put(particles);
+  m_genvhandle.put(vertices);
+}
+
 StatusCode PythiaInterface::finalize() {
 
   m_pythiaSignal.reset();
+  m_pythiaPool.clear();
   return GaudiTool::finalize();
 }
@@ -6,13 +6,16 @@
 #include "Generation/IHepMCProviderTool.h"
 #include "Generation/IVertexSmearingTool.h"
 #include <memory>
+#include <vector>
 
 // Forward HepMC
 namespace HepMC {
 class GenEvent;
+class Pythia8ToHepMC;
 }
 // Forward Pythia
 namespace Pythia8 {
+class Event;
 class Pythia;
 class SlowJet;
 class JetMatchingMadgraph;
@@ -22,6 +25,9 @@ class amcnlo_unitarised_interface;
 // Forward FCC EDM
 namespace fcc {
 class FloatValueCollection;
+class GenVertex;
+class GenVertexCollection;
+class MCParticleCollection;
 }
 
 class PythiaInterface : public GaudiTool, virtual public IHepMCProviderTool {
@@ -32,13 +38,69 @@ public:
   virtual StatusCode initialize();
   virtual StatusCode finalize();
   virtual StatusCode getNextEvent(HepMC::GenEvent& theEvent);
+  /** Generate several events (e.g. pileup), in parallel if a pool of Pythia instances is configured (numThreads > 0).
+   *  Each event is generated with a seed derived from the call number and the index of the event,
+   *  so that the events do not depend on the number of threads.
+   *  @param[in] aNumEvents number of events to generate
+   *  @param[out] aEvents vector the events are appended to
+   */
+  virtual StatusCode getNextEvents(unsigned int aNumEvents, std::vector<HepMC::GenEvent>& aEvents) override;
 
 private:
+  /** Generate the events of a pool worker: events aFirst + aWorker, aFirst + aWorker + numThreads, ...
+   *  @param[in] aWorker index of the worker (and of its Pythia instance)
+   *  @param[in,out] aEvents events to fill, already allocated
+   *  @param[in] aFirst index of the first event to fill
+   *  @return true on success, false if too many events failed to be generated
+   */
+  bool generateInPool(unsigned int aWorker, std::vector<HepMC::GenEvent>& aEvents, size_t aFirst);
+  /** Seed of an event generated by the pool
+   *  @param[in] aCall number of the call to getNextEvents()
+   *  @param[in] aIndex index of the event in the call
+   */
+  int poolSeed(unsigned int aCall, unsigned int aIndex) const;
+  /** Convert the Pythia event directly to the EDM collections, without going through HepMC.
+   *  Follows the topology of the HepMC conversion: the daughters of a particle share its end vertex.
+   *  @param[in] aEvent the generated event
+   */
+  void fillEDM(const Pythia8::Event& aEvent);
+
   /// Pythia8 engine
   std::unique_ptr<Pythia8::Pythia> m_pythiaSignal;
   /// Name of Pythia configuration file with Pythia simulation settings & input LHE file (if required)
   Gaudi::Property<std::string> m_parfile{this, "Filename", "Generation/data/Pythia_minbias_pp_100TeV.cmd"
                                                            "Name of the Pythia cmd file"};
+  /// Number of Pythia instances generating the events of getNextEvents() in parallel (0: use the main instance)
+  Gaudi::Property<unsigned int> m_numThreads{this, "numThreads", 0,
+                                             "Number of Pythia instances generating the pileup events in parallel"};
+  /// Seed from which the seeds of the events generated by the pool are derived
+  Gaudi::Property<int> m_poolSeed{this, "poolSeed", 1, "Base seed of the events generated by the Pythia pool"};
+  /// Pool of Pythia8 engines used by getNextEvents(), one per thread
+  std::vector<std::unique_ptr<Pythia8::Pythia>> m_pythiaPool;
+  /// Number of calls to getNextEvents() with the pool
+  unsigned int m_iPoolCall{0};
+  /// Flag whether to fill the HepMC event (can be switched off if only the EDM output is used)
+  Gaudi::Property<bool> m_saveHepMC{this, "saveHepMC", true, "Fill the HepMC event"};
+  /** Flag whether to convert the Pythia event directly to the EDM collections.
+   *  Only available for the signal provider and without the pool: the collections hold the signal event only,
+   *  before the pileup is merged and with the vertices as generated by Pythia (not smeared by GenAlg).
+   */
+  Gaudi::Property<bool> m_saveEDM{this, "saveEDM", false,
+                                  "Write the signal particles and vertices (unsmeared, without pileup) to the EDM"};
+  /// List of statuses (in the HepMC convention) of the particles written to the EDM; empty list keeps all particles
+  Gaudi::Property<std::vector<unsigned int>> m_edmStatusList{
+      this, "edmStatusList", {1}, "list of hepmc statuses of the particles written to the EDM; empty keeps all"};
+  /// Handle for the genparticles to be written
+  DataHandle<fcc::MCParticleCollection> m_genphandle{"genParticles", Gaudi::DataHandle::Writer, this};
+  /// Handle for the genvertices to be written
+  DataHandle<fcc::GenVertexCollection> m_genvhandle{"genVertices", Gaudi::DataHandle::Writer, this};
+  /// Whether a particle of given HepMC status is written to the EDM, built from m_edmStatusList
+  std::vector<bool> m_keepStatus;
+  /// Vertices shared by the daughters of a particle, indexed by the first mother (cleared after each event,
+  /// the capacity is reused)
+  std::vector<fcc::GenVertex> m_sharedVertices;
+  /// Interface for conversion from Pythia8::Event to HepMC event
+  std::unique_ptr<HepMC::Pythia8ToHepMC> m_toHepMC;
   /// Pythia8 engine for jet clustering
   std::unique_ptr<Pythia8::SlowJet> m_slowJet{nullptr};
   // Tool to smear vertices
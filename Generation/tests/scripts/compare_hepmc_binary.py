@@ -0,0 +1,24 @@
+# The events read from the binary container must have the same particles and vertices as the written ones.
+# The reader starts at event 5 (firstEvent in hepmcBinaryReader.py), both files are in the HepMC text format.
+def read_events(filename):
+    events = []
+    with open(filename) as hepmc_file:
+        for line in hepmc_file:
+            if line.startswith("E "):
+                events.append([])
+            if events and not line.startswith("HepMC::"):
+                events[-1].append(line)
+    return events
+
+source = read_events("hepmc_binary_test_source.dat")
+read = read_events("hepmc_binary_test_read.dat")
+
+first_event = 5
+assert(len(source) == 10)
+assert(len(read) == 5)
+for iev, (written, read_back) in enumerate(zip(source[first_event:], read)):
+    assert(sum(line.startswith("V ") for line in read_back) > 0)
+    assert(sum(line.startswith("P ") for line in read_back) > 0)
+    assert(len(written) == len(read_back)), "Event %d has a different number of lines" % (iev + first_event)
+    for written_line, read_line in zip(written, read_back):
+        assert written_line == read_line, "Event %d differs:\n%s%s" % (iev + first_event, written_line, read_line)
@@ -0,0 +1,9 @@
+# The pileup generated by the Pythia pool must not depend on the number of threads
+with open("pythia_pool_1threads.dat") as one_thread, open("pythia_pool_3threads.dat") as three_threads:
+    lines_one = one_thread.readlines()
+    lines_three = three_threads.readlines()
+
+assert(len(lines_one) > 0)
+assert(len(lines_one) == len(lines_three))
+for iline, (one, three) in enumerate(zip(lines_one, lines_three)):
+    assert one == three, "HepMC output differs at line %d" % (iline + 1)
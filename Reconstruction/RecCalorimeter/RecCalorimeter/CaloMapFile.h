@@ -0,0 +1,225 @@
+#ifndef RECCALORIMETER_CALOMAPFILE_H
+#define RECCALORIMETER_CALOMAPFILE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/** @class CaloMapFile Reconstruction/RecCalorimeter/RecCalorimeter/CaloMapFile.h CaloMapFile.h
+ *
+ *  Compact binary format of the per-cell calorimeter maps (neighbours and noise levels).
+ *  Layout (native byte order, all sections 8-byte aligned):
+ *   - Header (magic, version, content flags, number of cells and of neighbour entries),
+ *   - cellIDs sorted in increasing order [numCells],
+ *   - if kNeighbours: CSR offsets [numCells + 1] and neighbour cellIDs [numNeighbours],
+ *   - if kNoise: noise level (RMS) [numCells] and noise offset [numCells].
+ *  The file is mapped read-only, so that several jobs on the same node share the pages and no parsing is needed.
+ *  Lookups are a binary search in the sorted cellIDs; a cell missing from the map is never inserted.
+ *  Maps read from the legacy ROOT files are converted to the same layout in memory (see assign()).
+ */
+
+namespace rec {
+class CaloMapFile {
+public:
+  /// Content stored in the file
+  enum Content : uint32_t { kNeighbours = 1, kNoise = 2 };
+  /// Current version of the format
+  static constexpr uint32_t kVersion = 1;
+  /// File header
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t content;
+    uint64_t numCells;
+    uint64_t numNeighbours;
+  };
+
+  CaloMapFile() = default;
+  CaloMapFile(const CaloMapFile&) = delete;
+  CaloMapFile& operator=(const CaloMapFile&) = delete;
+  ~CaloMapFile() { unmap(); }
+
+  /// Check whether the file starts with the magic word of the binary format
+  static bool isMapFile(const std::string& aFileName) {
+    std::ifstream file(aFileName, std::ios::binary);
+    char fileMagic[sizeof(Header::magic)];
+    return file.read(fileMagic, sizeof(fileMagic)) && std::memcmp(fileMagic, magic(), sizeof(fileMagic)) == 0;
+  }
+
+  /** Write the map to a binary file.
+   *  @param[in] aFileName name of the output file
+   *  @param[in] aCellIds cellIDs, sorted in increasing order
+   *  @param[in] aOffsets CSR offsets of the neighbours (size aCellIds.size() + 1), empty if no neighbours are stored
+   *  @param[in] aNeighbours cellIDs of the neighbours
+   *  @param[in] aNoiseLevel noise RMS per cell, empty if no noise is stored
+   *  @param[in] aNoiseOffset noise offset per cell
+   *  @return true on success
+   */
+  static bool write(const std::string& aFileName, const std::vector<uint64_t>& aCellIds,
+                    const std::vector<uint64_t>& aOffsets, const std::vector<uint64_t>& aNeighbours,
+                    const std::vector<double>& aNoiseLevel, const std::vector<double>& aNoiseOffset) {
+    Header header;
+    std::memcpy(header.magic, magic(), sizeof(header.magic));
+    header.version = kVersion;
+    header.content = (aOffsets.empty() ? 0 : kNeighbours) | (aNoiseLevel.empty() ? 0 : kNoise);
+    header.numCells = aCellIds.size();
+    header.numNeighbours = aNeighbours.size();
+    std::ofstream file(aFileName, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    writeSection(file, aCellIds);
+    if (header.content & kNeighbours) {
+      writeSection(file, aOffsets);
+      writeSection(file, aNeighbours);
+    }
+    if (header.content & kNoise) {
+      writeSection(file, aNoiseLevel);
+      writeSection(file, aNoiseOffset);
+    }
+    return bool(file);
+  }
+
+  /** Map a binary file read-only.
+   *  @param[in] aFileName name of the input file
+   *  @param[out] aError reason of the failure
+   *  @return true on success
+   */
+  bool open(const std::string& aFileName, std::string& aError) {
+    unmap();
+    int fd = ::open(aFileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+      aError = "cannot open file " + aFileName;
+      return false;
+    }
+    struct stat status;
+    if (::fstat(fd, &status) != 0 || size_t(status.st_size) < sizeof(Header)) {
+      ::close(fd);
+      aError = "file " + aFileName + " is too short";
+      return false;
+    }
+    void* address = ::mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+      aError = "cannot map file " + aFileName;
+      return false;
+    }
+    m_mapped = address;
+    m_mappedSize = status.st_size;
+    const auto header = static_cast<const Header*>(address);
+    if (std::memcmp(header->magic, magic(), sizeof(header->magic)) != 0 || header->version != kVersion) {
+      unmap();
+      aError = "file " + aFileName + " is not a calorimeter map file of version " + std::to_string(kVersion);
+      return false;
+    }
+    const size_t numCells = header->numCells;
+    size_t expectedSize = sizeof(Header) + numCells * sizeof(uint64_t);
+    if (header->content & kNeighbours) expectedSize += (numCells + 1 + header->numNeighbours) * sizeof(uint64_t);
+    if (header->content & kNoise) expectedSize += 2 * numCells * sizeof(double);
+    if (m_mappedSize != expectedSize) {
+      unmap();
+      aError = "file " + aFileName + " has an inconsistent size";
+      return false;
+    }
+    auto data = reinterpret_cast<const uint64_t*>(header + 1);
+    m_numCells = numCells;
+    m_cellIds = data;
+    data += numCells;
+    if (header->content & kNeighbours) {
+      m_offsets = data;
+      m_neighbours = data + numCells + 1;
+      data += numCells + 1 + header->numNeighbours;
+    }
+    if (header->content & kNoise) {
+      m_noiseLevel = reinterpret_cast<const double*>(data);
+      m_noiseOffset = m_noiseLevel + numCells;
+    }
+    return true;
+  }
+
+  /** Take the map from memory (e.g. converted from a ROOT file), with the same layout as the binary file.
+   *  The arguments follow write(), the vectors are moved.
+   */
+  void assign(std::vector<uint64_t>&& aCellIds, std::vector<uint64_t>&& aOffsets, std::vector<uint64_t>&& aNeighbours,
+              std::vector<double>&& aNoiseLevel, std::vector<double>&& aNoiseOffset) {
+    unmap();
+    m_ownedCellIds = std::move(aCellIds);
+    m_ownedOffsets = std::move(aOffsets);
+    m_ownedNeighbours = std::move(aNeighbours);
+    m_ownedNoiseLevel = std::move(aNoiseLevel);
+    m_ownedNoiseOffset = std::move(aNoiseOffset);
+    m_numCells = m_ownedCellIds.size();
+    m_cellIds = m_ownedCellIds.data();
+    m_offsets = m_ownedOffsets.empty() ? nullptr : m_ownedOffsets.data();
+    m_neighbours = m_ownedNeighbours.data();
+    m_noiseLevel = m_ownedNoiseLevel.empty() ? nullptr : m_ownedNoiseLevel.data();
+    m_noiseOffset = m_ownedNoiseOffset.data();
+  }
+
+  /// Number of cells in the map
+  size_t size() const { return m_numCells; }
+  /// Whether the map contains the neighbours
+  bool hasNeighbours() const { return m_offsets != nullptr; }
+  /// Whether the map contains the noise levels
+  bool hasNoise() const { return m_noiseLevel != nullptr; }
+  /// Index of the cell in the map, size() if the cell is not in the map
+  size_t index(uint64_t aCellId) const {
+    const uint64_t* end = m_cellIds + m_numCells;
+    const uint64_t* it = std::lower_bound(m_cellIds, end, aCellId);
+    return (it != end && *it == aCellId) ? it - m_cellIds : m_numCells;
+  }
+  /// First neighbour of the cell at given index
+  const uint64_t* neighboursBegin(size_t aIndex) const { return m_neighbours + m_offsets[aIndex]; }
+  /// End of the neighbours of the cell at given index
+  const uint64_t* neighboursEnd(size_t aIndex) const { return m_neighbours + m_offsets[aIndex + 1]; }
+  /// Noise RMS of the cell at given index
+  double noiseLevel(size_t aIndex) const { return m_noiseLevel[aIndex]; }
+  /// Noise offset of the cell at given index
+  double noiseOffset(size_t aIndex) const { return m_noiseOffset[aIndex]; }
+
+private:
+  /// Magic word at the beginning of the file (8 bytes including the terminating null)
+  static const char* magic() { return "FCCCMAP"; }
+
+  template <typename T>
+  static void writeSection(std::ofstream& aFile, const std::vector<T>& aData) {
+    aFile.write(reinterpret_cast<const char*>(aData.data()), aData.size() * sizeof(T));
+  }
+  void unmap() {
+    if (m_mapped != nullptr) ::munmap(m_mapped, m_mappedSize);
+    m_mapped = nullptr;
+    m_mappedSize = 0;
+    m_numCells = 0;
+    m_cellIds = nullptr;
+    m_offsets = nullptr;
+    m_neighbours = nullptr;
+    m_noiseLevel = nullptr;
+    m_noiseOffset = nullptr;
+  }
+
+  /// Mapped file (nullptr if the map is held in memory)
+  void* m_mapped = nullptr;
+  size_t m_mappedSize = 0;
+  /// Views of the sections, pointing either to the mapped file or to the owned vectors
+  size_t m_numCells = 0;
+  const uint64_t* m_cellIds = nullptr;
+  const uint64_t* m_offsets = nullptr;
+  const uint64_t* m_neighbours = nullptr;
+  const double* m_noiseLevel = nullptr;
+  const double* m_noiseOffset = nullptr;
+  /// Storage of a map converted from a ROOT file
+  std::vector<uint64_t> m_ownedCellIds;
+  std::vector<uint64_t> m_ownedOffsets;
+  std::vector<uint64_t> m_ownedNeighbours;
+  std::vector<double> m_ownedNoiseLevel;
+  std::vector<double> m_ownedNoiseOffset;
+};
+}
+
+#endif /* RECCALORIMETER_CALOMAPFILE_H */
@@ -0,0 +1,44 @@
+#ifndef RECCALORIMETER_CELLPOSITIONSCACHE_H
+#define RECCALORIMETER_CELLPOSITIONSCACHE_H
+
+// DD4hep
+#include "DD4hep/Objects.h"
+
+#include <cstdint>
+#include <unordered_map>
+
+/** @class CellPositionsCache Reconstruction/RecCalorimeter/RecCalorimeter/CellPositionsCache.h CellPositionsCache.h
+ *
+ *  Table of the global positions of calorimeter cells, filled lazily by the cell positions tools.
+ *  The position of a cell only depends on the geometry, so the volume lookup and the world transformation
+ *  are done once per cell for the whole job; all following calls are a single hash lookup.
+ *  References to the stored positions stay valid until clear() is called.
+ */
+
+namespace rec {
+class CellPositionsCache {
+public:
+  /** Position of the cell, computed on the first request.
+   *  @param[in] aCellId cellID of the cell
+   *  @param[in] aCompute callable returning the position of a cell from the geometry, called once per cellID
+   *  @return global position of the cell
+   */
+  template <typename Compute>
+  const dd4hep::Position& position(uint64_t aCellId, Compute&& aCompute) {
+    auto it = m_positions.find(aCellId);
+    if (it == m_positions.end()) {
+      it = m_positions.emplace(aCellId, aCompute(aCellId)).first;
+    }
+    return it->second;
+  }
+  /// Number of cached cells
+  size_t size() const { return m_positions.size(); }
+  /// Remove all cached positions (e.g. if the geometry changes)
+  void clear() { m_positions.clear(); }
+
+private:
+  std::unordered_map<uint64_t, dd4hep::Position> m_positions;
+};
+}
+
+#endif /* RECCALORIMETER_CELLPOSITIONSCACHE_H */
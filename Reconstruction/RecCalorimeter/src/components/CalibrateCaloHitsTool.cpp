@@ -22,4 +22,10 @@ void CalibrateCaloHitsTool::calibrate(std::unordered_map<uint64_t, double>& aHit
                 [this](std::pair<const uint64_t, double>& p) { p.second *= m_invSamplingFraction; });
 }
 
+void CalibrateCaloHitsTool::calibrate(const std::vector<uint64_t>&, std::vector<double>& aEnergies) {
+  for (auto& energy : aEnergies) {
+    energy *= m_invSamplingFraction;
+  }
+}
+
 StatusCode CalibrateCaloHitsTool::finalize() { return GaudiTool::finalize(); }
@@ -44,4 +44,22 @@ void CalibrateInLayersTool::calibrate(std::unordered_map<uint64_t, double>& aHit
   });
 }
 
+void CalibrateInLayersTool::calibrate(const std::vector<uint64_t>& aCellIds, std::vector<double>& aEnergies) {
+  auto decoder = m_geoSvc->lcdd()->readout(m_readoutName).idSpec().decoder();
+  const auto& layerField = (*decoder)[m_layerFieldName.value()];
+  // Loop through energy deposits, multiply energy to get cell energy at electromagnetic scale
+  for (size_t iCell = 0; iCell < aCellIds.size(); iCell++) {
+    // shift layer id if the numbering does not start at 0
+    uint layer = layerField.value(aCellIds[iCell]) - m_firstLayerId;
+    if (layer < m_samplingFraction.size()) {
+      aEnergies[iCell] /= m_samplingFraction[layer];
+    } else {
+      aEnergies[iCell] /= m_samplingFraction[m_samplingFraction.size() - 1];
+      warning() << "Size of sampling fraction values is smaller than the number of existing layers."
+                << " Taking the sampling fraction for last layer."
+                << " Layer ID: " << layer << endmsg;
+    }
+  }
+}
+
 StatusCode CalibrateInLayersTool::finalize() { return GaudiTool::finalize(); }
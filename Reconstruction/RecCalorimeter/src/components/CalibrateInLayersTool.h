@@ -42,6 +42,9 @@ public:
   /** @brief  Calibrate Geant4 hit energy to EM scale
    */
   virtual void calibrate(std::unordered_map<uint64_t, double>& aHits) final;
+  /** @brief  Calibrate Geant4 hit energy to EM scale, for cells stored in parallel arrays
+   */
+  virtual void calibrate(const std::vector<uint64_t>& aCellIds, std::vector<double>& aEnergies) final;
 
 private:
   /// Pointer to the geometry service
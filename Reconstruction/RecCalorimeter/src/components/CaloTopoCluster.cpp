@@ -16,6 +16,7 @@
 #include "DD4hep/Readout.h"
 
 #include <algorithm>
+#include <cmath>
 #include <map>
 #include <numeric>
 #include <unordered_map>
@@ -74,10 +75,10 @@ StatusCode CaloTopoCluster::initialize() {
 }
 
 StatusCode CaloTopoCluster::execute() {
-  
+
   std::map<uint64_t, double> allCells;
-  std::vector<std::pair<uint64_t, double>> firstSeeds;
-  
+  std::vector<std::pair<uint, double>> firstSeeds;
+
   // get input cell map from input tool
   StatusCode sc_prepareCellMap = m_inputTool->cellIdMap(allCells);
   if (sc_prepareCellMap.isFailure()) {
@@ -85,29 +86,33 @@ StatusCode CaloTopoCluster::execute() {
     return StatusCode::FAILURE;
   }
   debug() << "Active Cells          :    " << allCells.size() << endmsg;
- 
+  CaloTopoCluster::fillCellArrays(allCells);
+
   // Create output collections
   auto edmClusters = m_clusterCollection.createAndPut();
   fcc::CaloHitCollection* edmClusterCells = new fcc::CaloHitCollection();
 
   // Finds seeds
-  CaloTopoCluster::findingSeeds(allCells, m_seedSigma, firstSeeds);
+  CaloTopoCluster::findingSeeds(m_seedSigma, firstSeeds);
   debug() << "Number of seeds found :    " << firstSeeds.size() << endmsg;
 
   // decending order of seeds
   std::sort(firstSeeds.begin(), firstSeeds.end(),
-            [](const std::pair<uint64_t, double>& lhs, const std::pair<uint64_t, double>& rhs) {
+            [](const std::pair<uint, double>& lhs, const std::pair<uint, double>& rhs) {
               return lhs.second < rhs.second;
             });
 
-  std::map<uint, std::vector<std::pair<uint64_t, uint>>> preClusterCollection;
-  CaloTopoCluster::buildingProtoCluster(m_neighbourSigma, m_lastNeighbourSigma, firstSeeds, allCells,
-                                        preClusterCollection);
+  // cluster IDs start at 1, entry 0 is never filled
+  std::vector<std::vector<std::pair<uint, uint>>> preClusterCollection(firstSeeds.size() + 1);
+  CaloTopoCluster::buildingProtoCluster(m_neighbourSigma, m_lastNeighbourSigma, firstSeeds, preClusterCollection);
   // Build Clusters in edm
-  debug() << "Building " << preClusterCollection.size() << " cluster." << endmsg;
   double checkTotEnergy = 0.;
   int clusterWithMixedCells = 0;
-  for (auto i : preClusterCollection) {
+  uint numClusters = 0;
+  uint numClusteredCells = 0;
+  for (const auto& i : preClusterCollection) {
+    if (i.empty()) continue;
+    numClusters++;
     fcc::CaloCluster cluster;
     auto& clusterCore = cluster.core();
     double posX = 0.;
@@ -116,12 +121,11 @@ StatusCode CaloTopoCluster::execute() {
     double energy = 0.;
     std::map<int,int> system;
 
-    for (auto pair : i.second) {
-      dd4hep::DDSegmentation::CellID cID = pair.first;
-	//      auto cellId = pair.first;
-      // get CaloHit by cellID
+    for (const auto& pair : i) {
+      dd4hep::DDSegmentation::CellID cID = m_cellIds[pair.first];
+      // get CaloHit by cell index
       auto newCell = edmClusterCells->create();
-      newCell.core().energy = allCells[cID];
+      newCell.core().energy = m_cellEnergies[pair.first];
       newCell.core().cellId = cID;
       newCell.core().bits = pair.second;
       energy += newCell.core().energy;
@@ -151,9 +155,8 @@ StatusCode CaloTopoCluster::execute() {
       posX += posCell.X() * newCell.core().energy;
       posY += posCell.Y() * newCell.core().energy;
       posZ += posCell.Z() * newCell.core().energy;
-      // edmClusterCells->push_back(newCell);
       cluster.addhits(newCell);
-      allCells.erase(cID);
+      numClusteredCells++;
     }
     clusterCore.energy = energy;
     clusterCore.position.x = posX / energy;
@@ -166,26 +169,53 @@ StatusCode CaloTopoCluster::execute() {
     if (system.size() > 1)
       clusterWithMixedCells++;
   }
+  debug() << "Built " << numClusters << " cluster." << endmsg;
   m_clusterCellsCollection.put(edmClusterCells);
   debug() << "Number of clusters with cells in E and HCal:        " << clusterWithMixedCells << endmsg;
   debug() << "Total energy of clusters:                                      " << checkTotEnergy << endmsg;
-  debug() << "Leftover cells :                                                     " << allCells.size() << endmsg;
+  debug() << "Leftover cells :                                                     "
+          << m_cellIds.size() - numClusteredCells << endmsg;
   return StatusCode::SUCCESS;
 }
 
-void CaloTopoCluster::findingSeeds(const std::map<uint64_t, double>& aCells,
-                                   int aNumSigma,
-                                   std::vector<std::pair<uint64_t, double>>& aSeeds) {
+void CaloTopoCluster::fillCellArrays(const std::map<uint64_t, double>& aCells) {
+  // std::map is ordered in cellID, so the arrays are sorted and can be searched by bisection
+  m_cellIds.clear();
+  m_cellEnergies.clear();
+  m_cellNoiseOffsets.clear();
+  m_cellNoiseRMS.clear();
+  m_cellIds.reserve(aCells.size());
+  m_cellEnergies.reserve(aCells.size());
+  m_cellNoiseOffsets.reserve(aCells.size());
+  m_cellNoiseRMS.reserve(aCells.size());
   for (const auto& cell : aCells) {
-    // retrieve the noise const and offset assigned to cell
-    double threshold = m_noiseTool->noiseOffset(cell.first) + ( m_noiseTool->noiseRMS(cell.first) * aNumSigma);
+    m_cellIds.push_back(cell.first);
+    m_cellEnergies.push_back(cell.second);
+    m_cellNoiseOffsets.push_back(m_noiseTool->noiseOffset(cell.first));
+    m_cellNoiseRMS.push_back(m_noiseTool->noiseRMS(cell.first));
+  }
+  m_clusterOfCell.assign(aCells.size(), 0);
+}
+
+uint CaloTopoCluster::cellIndex(uint64_t aCellId) const {
+  auto it = std::lower_bound(m_cellIds.begin(), m_cellIds.end(), aCellId);
+  if (it != m_cellIds.end() && *it == aCellId) {
+    return std::distance(m_cellIds.begin(), it);
+  }
+  return m_cellIds.size();
+}
+
+void CaloTopoCluster::findingSeeds(int aNumSigma, std::vector<std::pair<uint, double>>& aSeeds) {
+  for (uint iCell = 0; iCell < m_cellIds.size(); iCell++) {
+    // noise const and offset assigned to cell
+    double threshold = m_cellNoiseOffsets[iCell] + (m_cellNoiseRMS[iCell] * aNumSigma);
     if (msgLevel() <= MSG::VERBOSE){
-      verbose() << "noise offset    = " << m_noiseTool->noiseOffset(cell.first) << "GeV " << endmsg;
-      verbose() << "noise rms       = " << m_noiseTool->noiseRMS(cell.first) << "GeV " << endmsg;
+      verbose() << "noise offset    = " << m_cellNoiseOffsets[iCell] << "GeV " << endmsg;
+      verbose() << "noise rms       = " << m_cellNoiseRMS[iCell] << "GeV " << endmsg;
       verbose() << "seed threshold  = " << threshold << "GeV " << endmsg;
     }
-    if (abs(cell.second) > threshold) {
-      aSeeds.emplace_back(cell.first, cell.second);
+    if (std::abs(m_cellEnergies[iCell]) > threshold) {
+      aSeeds.emplace_back(iCell, m_cellEnergies[iCell]);
     }
   }
 }
@@ -193,11 +223,11 @@ void CaloTopoCluster::findingSeeds(const std::map<uint64_t, double>& aCells,
 void CaloTopoCluster::buildingProtoCluster(
     int aNumSigma,
     int aLastNumSigma,
-    std::vector<std::pair<uint64_t, double>>& aSeeds,
-    const std::map<uint64_t, double>& aCells,
-    std::map<uint, std::vector< std::pair<uint64_t, uint>>>& aPreClusterCollection) {
-  // Map of cellIds to clusterIds
-  std::map<uint64_t, uint> clusterOfCell;
+    std::vector<std::pair<uint, double>>& aSeeds,
+    std::vector<std::vector<std::pair<uint, uint>>>& aPreClusterCollection) {
+  // Current and next shell of neighbours, reused for all seeds
+  std::vector<uint> currentNeighbours;
+  std::vector<uint> nextNeighbours;
 
   // Loop over every seed in Calo to create first cluster
   uint iSeeds = 0;
@@ -205,139 +235,114 @@ void CaloTopoCluster::buildingProtoCluster(
   for (auto& itSeed : aSeeds) {
     iSeeds++;
     verbose() << "Seed num: " << iSeeds << endmsg;
-    auto seedId = itSeed.first;
-    auto cellInCluster = clusterOfCell.find(seedId);
-    if (cellInCluster != clusterOfCell.end()) {
+    auto seedIndex = itSeed.first;
+    if (m_clusterOfCell[seedIndex] != 0) {
       verbose() << "Seed is already assigned to another cluster!" << endmsg;
       continue;
-    } else {
-      // new cluster starts with seed
-      // set cell Bits to 1 for seed cell
-      aPreClusterCollection[iSeeds].push_back(std::make_pair(seedId, 1));
-      uint clusterId = iSeeds;
-      clusterOfCell[seedId] = clusterId;
+    }
+    // new cluster starts with seed
+    // set cell Bits to 1 for seed cell
+    aPreClusterCollection[iSeeds].emplace_back(seedIndex, 1);
+    uint clusterId = iSeeds;
+    m_clusterOfCell[seedIndex] = clusterId;
 
-      std::vector<std::vector<std::pair<uint64_t, uint>>> vecNextNeighbours(100000);
-      vecNextNeighbours[0] = CaloTopoCluster::searchForNeighbours(seedId, clusterId, aNumSigma, aCells, clusterOfCell,
-                                                     aPreClusterCollection, true);
-      // first loop over seeds neighbours
-      verbose() << "Found " << vecNextNeighbours[0].size() << " neighbours.." << endmsg;
-      int it = 0;
-      while (vecNextNeighbours[it].size() > 0) {
-        it++;
-        for (auto& id : vecNextNeighbours[it - 1]) {
-          verbose() << "Next neighbours assigned to clusterId : " << clusterId << endmsg;
-          vecNextNeighbours[it] = CaloTopoCluster::searchForNeighbours(id.first, clusterId, aNumSigma, aCells, clusterOfCell,
-								       aPreClusterCollection, true);
-        }
-        verbose() << "Found " << vecNextNeighbours[it].size() << " more neighbours.." << endmsg;
-      }
-      // last try with different condition on neighbours
-      if (vecNextNeighbours[it].size() == 0) {
-	int newIt = -1;
-	if (it == 0) {
-	  newIt = 0;
-	}
-	else {
-	  newIt = it -1;
-	}
-	for (auto& id : vecNextNeighbours[newIt]) {
-	  verbose() << "Add neighbours of " << id.first << " in last round with thr = " << aLastNumSigma << " x sigma." << endmsg;
-	  auto lastNeighours = CaloTopoCluster::searchForNeighbours(id.first, clusterId, aLastNumSigma, aCells, clusterOfCell,
-								    aPreClusterCollection, false);
-	}
+    currentNeighbours.clear();
+    CaloTopoCluster::searchForNeighbours(seedIndex, clusterId, aNumSigma, aPreClusterCollection, currentNeighbours,
+                                         true);
+    // first loop over seeds neighbours
+    verbose() << "Found " << currentNeighbours.size() << " neighbours.." << endmsg;
+    // every found neighbour is used as seed for the next shell, until no more neighbours are found
+    while (true) {
+      nextNeighbours.clear();
+      for (auto& id : currentNeighbours) {
+        verbose() << "Next neighbours assigned to clusterId : " << clusterId << endmsg;
+        CaloTopoCluster::searchForNeighbours(id, clusterId, aNumSigma, aPreClusterCollection, nextNeighbours, true);
       }
+      verbose() << "Found " << nextNeighbours.size() << " more neighbours.." << endmsg;
+      if (nextNeighbours.empty()) break;
+      std::swap(currentNeighbours, nextNeighbours);
+    }
+    // last try with different condition on neighbours of the last shell
+    for (auto& id : currentNeighbours) {
+      verbose() << "Add neighbours of " << m_cellIds[id] << " in last round with thr = " << aLastNumSigma
+                << " x sigma." << endmsg;
+      CaloTopoCluster::searchForNeighbours(id, clusterId, aLastNumSigma, aPreClusterCollection, nextNeighbours, false);
     }
   }
 }
 
-std::vector<std::pair<uint64_t, uint> >
-CaloTopoCluster::searchForNeighbours(const uint64_t aCellId,
-                                     uint& aClusterID,
-                                     int aNumSigma,
-                                     const std::map<uint64_t, double>& aCells,
-                                     std::map<uint64_t, uint>& aClusterOfCell,
-                                     std::map<uint, std::vector<std::pair<uint64_t, uint>>>& aPreClusterCollection,
-				     bool aAllowClusterMerge) {
-  // Fill vector to be returned, next cell ids and cluster id for which neighbours are found
-  std::vector<std::pair<uint64_t, uint>> addedNeighbourIds;
+void CaloTopoCluster::searchForNeighbours(const uint aCellIndex,
+                                          uint& aClusterID,
+                                          int aNumSigma,
+                                          std::vector<std::vector<std::pair<uint, uint>>>& aPreClusterCollection,
+                                          std::vector<uint>& aNextNeighbours,
+                                          bool aAllowClusterMerge) {
   // Retrieve cellIds of neighbours
-  auto neighboursVec = m_neighboursTool->neighbours(aCellId);
-  if (neighboursVec.size() == 0) {
+  const auto neighboursVec = m_neighboursTool->neighbours(m_cellIds[aCellIndex]);
+  if (neighboursVec.empty()) {
     error() << "No neighbours for cellID found! " << endmsg;
-    addedNeighbourIds.resize(0);
-  } else {
-
-    verbose() << "For cluster: " << aClusterID << endmsg;
-    // loop over neighbours
-    for (auto& itr : neighboursVec) {
-      auto neighbourID = itr;
-      // Find the neighbour in the Calo cells list
-      auto itAllCells = aCells.find(neighbourID);
-      auto itAllUsedCells = aClusterOfCell.find(neighbourID);
+    return;
+  }
+  verbose() << "For cluster: " << aClusterID << endmsg;
+  const uint numCells = m_cellIds.size();
+  // loop over neighbours
+  for (auto neighbourID : neighboursVec) {
+    // Find the neighbour in the Calo cells list
+    uint neighbourIndex = cellIndex(neighbourID);
+    // If cell is not hit
+    if (neighbourIndex == numCells) continue;
+    uint neighbourClusterID = m_clusterOfCell[neighbourIndex];
 
-      // If cell is hit.. and is not assigned to a cluster
-      if (itAllCells != aCells.end() && itAllUsedCells == aClusterOfCell.end()) {
-        verbose() << "Found neighbour with CellID: " << neighbourID << endmsg;
-        auto neighbouringCellEnergy = itAllCells->second;
-        bool addNeighbour = false;
-	int cellType = 2;
-        if (aNumSigma == 0){  // no condition to be checked for neighbour
-          addNeighbour = true;
-	  cellType = 3;
-	}
-        else {
-          // retrieve the cell noise level [GeV]
-          double thr = m_noiseTool->noiseOffset(neighbourID) + (aNumSigma * m_noiseTool->noiseRMS(neighbourID));
-          if (abs(neighbouringCellEnergy) > thr)
-            addNeighbour = true;
-          else
-            addNeighbour = false;
-        }
-        // if neighbour is validated
-        if (addNeighbour) {
-          // retrieve the cell
-          // add neighbour to cells for cluster
-          aPreClusterCollection[aClusterID].push_back(std::make_pair(neighbourID, cellType));
-          aClusterOfCell[neighbourID] = aClusterID;
-          addedNeighbourIds.push_back(std::make_pair(neighbourID, aClusterID));
-        }
+    // If cell is hit.. and is not assigned to a cluster
+    if (neighbourClusterID == 0) {
+      verbose() << "Found neighbour with CellID: " << neighbourID << endmsg;
+      bool addNeighbour = false;
+      int cellType = 2;
+      if (aNumSigma == 0) {  // no condition to be checked for neighbour
+        addNeighbour = true;
+        cellType = 3;
+      } else {
+        // cell noise level [GeV]
+        double thr = m_cellNoiseOffsets[neighbourIndex] + (aNumSigma * m_cellNoiseRMS[neighbourIndex]);
+        addNeighbour = std::abs(m_cellEnergies[neighbourIndex]) > thr;
+      }
+      // if neighbour is validated
+      if (addNeighbour) {
+        // add neighbour to cells for cluster
+        aPreClusterCollection[aClusterID].emplace_back(neighbourIndex, cellType);
+        m_clusterOfCell[neighbourIndex] = aClusterID;
+        aNextNeighbours.push_back(neighbourIndex);
+      }
+    }
+    // If cell is hit.. but is assigned to another cluster
+    else if (neighbourClusterID != aClusterID && aAllowClusterMerge) {
+      uint clusterIDToMerge = neighbourClusterID;
+      auto& cellsToMerge = aPreClusterCollection[aClusterID];
+      auto& mergedCells = aPreClusterCollection[clusterIDToMerge];
+      if (msgLevel() <= MSG::VERBOSE) {
+        verbose() << "This neighbour was found in cluster " << clusterIDToMerge << ", cluster " << aClusterID
+                  << " will be merged!" << endmsg;
+        verbose() << "Assigning all cells ( " << cellsToMerge.size() << " ) to Cluster " << clusterIDToMerge
+                  << " with ( " << mergedCells.size() << " ). " << endmsg;
       }
-      // If cell is hit.. but is assigned to another cluster
-      else if (itAllUsedCells != aClusterOfCell.end() && itAllUsedCells->second != aClusterID && aAllowClusterMerge) {
-        uint clusterIDToMerge = itAllUsedCells->second;
-	if (msgLevel() <= MSG::VERBOSE){
-	  verbose() << "This neighbour was found in cluster " << clusterIDToMerge << ", cluster " << aClusterID
-		    << " will be merged!" << endmsg;
-	  verbose() << "Assigning all cells ( " << aPreClusterCollection.find(aClusterID)->second.size() << " ) to Cluster "
-		    << clusterIDToMerge << " with ( " << aPreClusterCollection.find(clusterIDToMerge)->second.size()
-		    << " ). " << endmsg;
-	}
-        // Fill all cells into cluster, and assigned cells to new cluster
-        aClusterOfCell[neighbourID] = clusterIDToMerge;
-        for (auto& i : aPreClusterCollection.find(aClusterID)->second) {
-          aClusterOfCell[i.first] = clusterIDToMerge;
-          bool found = false;
-          // make sure that already assigned cells are not added
-          for (auto& j : aPreClusterCollection[clusterIDToMerge]) {
-            if (j.first == i.first) found = true;
-          }
-          if (!found) {
-            aPreClusterCollection[clusterIDToMerge].push_back(std::make_pair(i.first, i.second));
-          }
-        }
-        aPreClusterCollection.erase(aClusterID);
-        // changed clusterId -> if more neighbours are found, correct assignment
-        verbose() << "Cluster Id changed to " << clusterIDToMerge << endmsg;
-        aClusterID = clusterIDToMerge;
-        // found neighbour for next search
-        addedNeighbourIds.push_back(std::make_pair(neighbourID, aClusterID));
-        // end loop to ensure correct cluster assignment
-        break;
+      // Fill all cells into cluster, and assigned cells to new cluster
+      // cells carry a single cluster label, so none of them can already be part of the cluster to merge
+      mergedCells.reserve(mergedCells.size() + cellsToMerge.size());
+      for (auto& i : cellsToMerge) {
+        m_clusterOfCell[i.first] = clusterIDToMerge;
+        mergedCells.push_back(i);
       }
+      cellsToMerge.clear();
+      cellsToMerge.shrink_to_fit();
+      // changed clusterId -> if more neighbours are found, correct assignment
+      verbose() << "Cluster Id changed to " << clusterIDToMerge << endmsg;
+      aClusterID = clusterIDToMerge;
+      // found neighbour for next search
+      aNextNeighbours.push_back(neighbourIndex);
+      // end loop to ensure correct cluster assignment
+      break;
     }
   }
-  return std::move(addedNeighbourIds);
 }
 
 StatusCode CaloTopoCluster::finalize() { return GaudiAlgorithm::finalize(); }
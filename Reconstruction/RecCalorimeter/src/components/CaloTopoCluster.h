@@ -48,45 +48,51 @@ public:
 
   StatusCode initialize();
 
+  /** Fill the per-event cell arrays from the input cell map.
+   *  Every cellID is mapped once to a compact index, which is its position in the cellID-sorted arrays.
+   *  The noise offset and RMS are retrieved once per cell, so the thresholds can be evaluated from the arrays.
+   *   @param[in] aCells, map of all cells (cellID and energy).
+   */
+  void fillCellArrays(const std::map<uint64_t, double>& aCells);
+
+  /** Get the compact index of a cell.
+   *   @param[in] aCellId, the cell ID.
+   *   return the index of the cell in the per-event arrays, or the number of cells if it is not a hit cell.
+   */
+  uint cellIndex(uint64_t aCellId) const;
+
   /**  Find cells with a signal to noise ratio > nSigma.
-   *   @param[in] aCells, parse the map of all cells.
    *   @param[in] aNumSigma, the signal to noise ratio that the cell has to exceed to become seed.
-   *   @param[in] aSeeds, the vector of seed cell ids anf their energy to build proto-clusters.
+   *   @param[in] aSeeds, the vector of seed cell indices and their energy to build proto-clusters.
    */
-  virtual void findingSeeds(const std::map<uint64_t, double>& aCells, int aNumSigma,
-                            std::vector<std::pair<uint64_t, double>>& aSeeds);
+  virtual void findingSeeds(int aNumSigma, std::vector<std::pair<uint, double>>& aSeeds);
 
   /** Building proto-clusters from the found seeds.
    * First the function initialises a cluster in the preClusterCollection for the seed cells,
-   * then it calls the CaloTopoCluster::searchForNeighbours function to retrieve the vector of next cellIDs to add and loop over to find neighbours.
+   * then it calls the CaloTopoCluster::searchForNeighbours function to retrieve the vector of next cell indices to add and loop over to find neighbours.
    * The iteration of search for neighbours is continued until no more neihgbours are found. Then a last round of adding neighbouring cells to the cluster is run where the parameter lastNeighbourSigma is applied.
    *   @param[in] aNumSigma, signal to noise ratio the neighbouring cell has to pass to be added to cluster.
+   *   @param[in] aLastNumSigma, signal to noise ratio the neighbouring cell has to pass to be added to cluster in the last round.
    *   @param[in] aSeeds, vector of seeding cells.
-   *   @param[in] aCells, map of all cells.
-   *   @param[in] aPreClusterCollection, map that is filled with clusterID pointing to the associated cells, in a pair of cellID and cellType.
+   *   @param[in] aPreClusterCollection, vector indexed by clusterID, filled with pairs of cell index and cellType.
    */
   virtual void buildingProtoCluster(int aNumSigma,
                                     int aLastNumSigma,
-                                    std::vector<std::pair<uint64_t, double>>& aSeeds,
-                                    const std::map<uint64_t, double>& aCells,
-                                    std::map<uint, std::vector<std::pair<uint64_t, uint>>>& aPreClusterCollection);
+                                    std::vector<std::pair<uint, double>>& aSeeds,
+                                    std::vector<std::vector<std::pair<uint, uint>>>& aPreClusterCollection);
 
   /** Search for neighbours and add them to preClusterCollection
-   * The 
-   *   @param[in] aCellId, the cell ID for which to find the neighbours.
+   * The found neighbours are labelled with the cluster ID in the cluster label array and appended to aNextNeighbours.
+   *   @param[in] aCellIndex, the index of the cell for which to find the neighbours.
    *   @param[in] aClusterID, the current cluster ID.
    *   @param[in] aNumSigma, the signal/noise ratio to be exceeded by the neighbouring cell to be added to cluster.
-   *   @param[in] aCells, map of all cells.
-   *   @param[in] aClusterOfCell, map of cellID to clusterID.
-   *   @param[in] aPreClusterCollection, map that is filled with clusterID pointing to the associated cells, in a pair of cellID and cellType.
+   *   @param[in] aPreClusterCollection, vector indexed by clusterID, filled with pairs of cell index and cellType.
+   *   @param[in] aNextNeighbours, vector of indices of found neighbours, to which the new neighbours are appended.
    *   @param[in] aAllowClusterMerge, bool to allow for clusters to be merged, set to false in case of last iteration in CaloTopoCluster::buildingProtoCluster.
-   *   return vector of pairs with cellID and energy of found neighbours.
    */
-  std::vector<std::pair<uint64_t, uint>>
-  searchForNeighbours(const uint64_t aCellId, uint& aClusterID, int aNumSigma, const std::map<uint64_t, double>& aCells,
-                      std::map<uint64_t, uint>& aClusterOfCell,
-                      std::map<uint, std::vector<std::pair<uint64_t, uint>>>& aPreClusterCollection,
-		      bool aAllowClusterMerge);
+  void searchForNeighbours(const uint aCellIndex, uint& aClusterID, int aNumSigma,
+                           std::vector<std::vector<std::pair<uint, uint>>>& aPreClusterCollection,
+                           std::vector<uint>& aNextNeighbours, bool aAllowClusterMerge);
 
   StatusCode execute();
 
@@ -128,5 +134,13 @@ private:
   /// General decoder to encode the calorimeter sub-system to determine which positions tool to use
   dd4hep::DDSegmentation::BitFieldCoder* m_decoder = new dd4hep::DDSegmentation::BitFieldCoder("system:4");
 
+  /// Per-event cell arrays, indexed by the compact cell index (sorted in cellID)
+  std::vector<uint64_t> m_cellIds;
+  std::vector<double> m_cellEnergies;
+  std::vector<double> m_cellNoiseOffsets;
+  std::vector<double> m_cellNoiseRMS;
+  /// Cluster label of each cell (0 if the cell is not assigned to any cluster)
+  std::vector<uint> m_clusterOfCell;
+
 };
 #endif /* RECCALORIMETER_CALOTOPOCLUSTER_H */
@@ -109,6 +109,14 @@ tower CaloTowerTool::towersNumber() {
   debug() << "Towers: etaMax " << m_etaMax << ", deltaEtaTower " << m_deltaEtaTower << ", nEtaTower " << m_nEtaTower << endmsg;
   debug() << "Towers: phiMax " << m_phiMax << ", deltaPhiTower " << m_deltaPhiTower << ", nPhiTower " << m_nPhiTower << endmsg;
 
+  // tower tables depend on the number of towers
+  for (auto table : {&m_ecalBarrelTowerTable, &m_ecalEndcapTowerTable, &m_ecalFwdTowerTable, &m_hcalBarrelTowerTable,
+                     &m_hcalExtBarrelTowerTable, &m_hcalEndcapTowerTable, &m_hcalFwdTowerTable}) {
+    table->ranges.clear();
+    table->fractions.clear();
+  }
+  m_towers.assign(m_nEtaTower * m_nPhiTower, 0);
+
   tower total;
   total.eta = m_nEtaTower;
   total.phi = m_nPhiTower;
@@ -117,6 +125,7 @@ tower CaloTowerTool::towersNumber() {
 
 uint CaloTowerTool::buildTowers(std::vector<std::vector<float>>& aTowers) {
   uint totalNumberOfCells = 0;
+  std::fill(m_towers.begin(), m_towers.end(), 0);
 
   // 1. ECAL barrel
   // Get the input collection with calorimeter cells
@@ -124,7 +133,7 @@ uint CaloTowerTool::buildTowers(std::vector<std::vector<float>>& aTowers) {
   debug() << "Input Ecal barrel cell collection size: " << ecalBarrelCells->size() << endmsg;
   // Loop over a collection of calorimeter cells and build calo towers
   if (m_ecalBarrelSegmentation != nullptr) {
-    CellsIntoTowers(aTowers, ecalBarrelCells, m_ecalBarrelSegmentation);
+    CellsIntoTowers(ecalBarrelCells, m_ecalBarrelSegmentation, m_ecalBarrelTowerTable);
     totalNumberOfCells += ecalBarrelCells->size();
   }
 
@@ -133,7 +142,7 @@ uint CaloTowerTool::buildTowers(std::vector<std::vector<float>>& aTowers) {
   debug() << "Input Ecal endcap cell collection size: " << ecalEndcapCells->size() << endmsg;
   // Loop over a collection of calorimeter cells and build calo towers
   if (m_ecalEndcapSegmentation != nullptr) {
-    CellsIntoTowers(aTowers, ecalEndcapCells, m_ecalEndcapSegmentation);
+    CellsIntoTowers(ecalEndcapCells, m_ecalEndcapSegmentation, m_ecalEndcapTowerTable);
     totalNumberOfCells += ecalEndcapCells->size();
   }
 
@@ -142,7 +151,7 @@ uint CaloTowerTool::buildTowers(std::vector<std::vector<float>>& aTowers) {
   debug() << "Input Ecal forward cell collection size: " << ecalFwdCells->size() << endmsg;
   // Loop over a collection of calorimeter cells and build calo towers
   if (m_ecalFwdSegmentation != nullptr) {
-    CellsIntoTowers(aTowers, ecalFwdCells, m_ecalFwdSegmentation);
+    CellsIntoTowers(ecalFwdCells, m_ecalFwdSegmentation, m_ecalFwdTowerTable);
     totalNumberOfCells += ecalFwdCells->size();
   }
 
@@ -151,7 +160,7 @@ uint CaloTowerTool::buildTowers(std::vector<std::vector<float>>& aTowers) {
   debug() << "Input hadronic barrel cell collection size: " << hcalBarrelCells->size() << endmsg;
   // Loop over a collection of calorimeter cells and build calo towers
   if (m_hcalBarrelSegmentation != nullptr) {
-    CellsIntoTowers(aTowers, hcalBarrelCells, m_hcalBarrelSegmentation);
+    CellsIntoTowers(hcalBarrelCells, m_hcalBarrelSegmentation, m_hcalBarrelTowerTable);
     totalNumberOfCells += hcalBarrelCells->size();
   }
 
@@ -160,7 +169,7 @@ uint CaloTowerTool::buildTowers(std::vector<std::vector<float>>& aTowers) {
   debug() << "Input hadronic extended barrel cell collection size: " << hcalExtBarrelCells->size() << endmsg;
   // Loop over a collection of calorimeter cells and build calo towers
   if (m_hcalExtBarrelSegmentation != nullptr) {
-    CellsIntoTowers(aTowers, hcalExtBarrelCells, m_hcalExtBarrelSegmentation);
+    CellsIntoTowers(hcalExtBarrelCells, m_hcalExtBarrelSegmentation, m_hcalExtBarrelTowerTable);
     totalNumberOfCells += hcalExtBarrelCells->size();
   }
 
@@ -169,7 +178,7 @@ uint CaloTowerTool::buildTowers(std::vector<std::vector<float>>& aTowers) {
   debug() << "Input Hcal endcap cell collection size: " << hcalEndcapCells->size() << endmsg;
   // Loop over a collection of calorimeter cells and build calo towers
   if (m_hcalEndcapSegmentation != nullptr) {
-    CellsIntoTowers(aTowers, hcalEndcapCells, m_hcalEndcapSegmentation);
+    CellsIntoTowers(hcalEndcapCells, m_hcalEndcapSegmentation, m_hcalEndcapTowerTable);
     totalNumberOfCells += hcalEndcapCells->size();
   }
 
@@ -178,10 +187,15 @@ uint CaloTowerTool::buildTowers(std::vector<std::vector<float>>& aTowers) {
   debug() << "Input Hcal forward cell collection size: " << hcalFwdCells->size() << endmsg;
   // Loop over a collection of calorimeter cells and build calo towers
   if (m_hcalFwdSegmentation != nullptr) {
-    CellsIntoTowers(aTowers, hcalFwdCells, m_hcalFwdSegmentation);
+    CellsIntoTowers(hcalFwdCells, m_hcalFwdSegmentation, m_hcalFwdTowerTable);
     totalNumberOfCells += hcalFwdCells->size();
   }
 
+  // copy the flat towers to the output
+  for (uint iEta = 0; iEta < std::min<uint>(aTowers.size(), m_nEtaTower); iEta++) {
+    std::copy_n(m_towers.begin() + iEta * m_nPhiTower, std::min<uint>(aTowers[iEta].size(), m_nPhiTower),
+                aTowers[iEta].begin());
+  }
   return totalNumberOfCells;
 }
 
@@ -216,10 +230,32 @@ uint CaloTowerTool::phiNeighbour(int aIPhi) const {
 
 float CaloTowerTool::radiusForPosition() const { return m_radius; }
 
-void CaloTowerTool::CellsIntoTowers(std::vector<std::vector<float>>& aTowers,
-                                            const fcc::CaloHitCollection* aCells,
-                                            dd4hep::DDSegmentation::FCCSWGridPhiEta* aSegmentation) {
-  // Loop over a collection of calorimeter cells and build calo towers
+void CaloTowerTool::CellsIntoTowers(const fcc::CaloHitCollection* aCells,
+                                    dd4hep::DDSegmentation::FCCSWGridPhiEta* aSegmentation, CellTowerTable& aTable) {
+  if (aTable.binMask == 0) {
+    const auto decoder = aSegmentation->decoder();
+    aTable.binMask = (*decoder)[aSegmentation->fieldNameEta()].mask() | (*decoder)[aSegmentation->fieldNamePhi()].mask();
+  }
+  float* towers = m_towers.data();
+  // Loop over a collection of calorimeter cells and add their transverse energy to the towers
+  for (const auto& cell : *aCells) {
+    auto range = aTable.ranges.find(cell.core().cellId & aTable.binMask);
+    if (range == aTable.ranges.end()) {
+      uint first = aTable.fractions.size();
+      cellTowers(cell.core().cellId, aSegmentation, aTable.fractions);
+      range = aTable.ranges.emplace(cell.core().cellId & aTable.binMask,
+                                    std::make_pair(first, uint(aTable.fractions.size()) - first)).first;
+    }
+    const float energy = cell.core().energy;
+    const TowerFraction* fraction = aTable.fractions.data() + range->second.first;
+    for (uint i = 0; i < range->second.second; i++) {
+      towers[fraction[i].towerIndex] += energy * fraction[i].weight;
+    }
+  }
+}
+
+void CaloTowerTool::cellTowers(uint64_t aCellId, dd4hep::DDSegmentation::FCCSWGridPhiEta* aSegmentation,
+                               std::vector<TowerFraction>& aFractions) const {
   // borders of the cell in eta/phi
   float etaCellMin = 0, etaCellMax = 0;
   float phiCellMin = 0, phiCellMax = 0;
@@ -234,65 +270,58 @@ void CaloTowerTool::CellsIntoTowers(std::vector<std::vector<float>>& aTowers,
   float fracEtaMin = 1.0, fracEtaMax = 1.0, fracEtaMiddle = 1.0;
   float fracPhiMin = 1.0, fracPhiMax = 1.0, fracPhiMiddle = 1.0;
   float epsilon = 0.0001;
-  for (const auto& cell : *aCells) {
-    // find to which tower(s) the cell belongs
-    etaCellMin = aSegmentation->eta(cell.core().cellId) - aSegmentation->gridSizeEta() * 0.5;
-    etaCellMax = aSegmentation->eta(cell.core().cellId) + aSegmentation->gridSizeEta() * 0.5;
-    phiCellMin = aSegmentation->phi(cell.core().cellId) - M_PI / (double)aSegmentation->phiBins();
-    phiCellMax = aSegmentation->phi(cell.core().cellId) + M_PI / (double)aSegmentation->phiBins();
-    iEtaMin = idEta(etaCellMin + epsilon);
-    iPhiMin = idPhi(phiCellMin + epsilon);
-    iEtaMax = idEta(etaCellMax - epsilon);
-    iPhiMax = idPhi(phiCellMax - epsilon);
-    // if a cell is larger than a tower in eta/phi, calculate the fraction of
-    // the cell area belonging to the first/last/middle towers
-    fracEtaMin = 1.0;
-    fracEtaMax = 1.0;
-    fracEtaMiddle = 1.0;
-    if (iEtaMin != iEtaMax) {
-      fracEtaMin = fabs(eta(iEtaMin) + 0.5 * m_deltaEtaTower - etaCellMin) / aSegmentation->gridSizeEta();
-      fracEtaMax = fabs(etaCellMax - eta(iEtaMax) + 0.5 * m_deltaEtaTower) / aSegmentation->gridSizeEta();
-      if ((iEtaMax - iEtaMin - 1) != 0) {
-        fracEtaMiddle = (1 - fracEtaMin - fracEtaMax) / float(iEtaMax - iEtaMin - 1);
-      } else {
-        fracEtaMiddle = 0.0;
-      }
+  // find to which tower(s) the cell belongs
+  const double etaCell = aSegmentation->eta(aCellId);
+  etaCellMin = etaCell - aSegmentation->gridSizeEta() * 0.5;
+  etaCellMax = etaCell + aSegmentation->gridSizeEta() * 0.5;
+  phiCellMin = aSegmentation->phi(aCellId) - M_PI / (double)aSegmentation->phiBins();
+  phiCellMax = aSegmentation->phi(aCellId) + M_PI / (double)aSegmentation->phiBins();
+  iEtaMin = idEta(etaCellMin + epsilon);
+  iPhiMin = idPhi(phiCellMin + epsilon);
+  iEtaMax = idEta(etaCellMax - epsilon);
+  iPhiMax = idPhi(phiCellMax - epsilon);
+  // if a cell is larger than a tower in eta/phi, calculate the fraction of
+  // the cell area belonging to the first/last/middle towers
+  if (iEtaMin != iEtaMax) {
+    fracEtaMin = fabs(eta(iEtaMin) + 0.5 * m_deltaEtaTower - etaCellMin) / aSegmentation->gridSizeEta();
+    fracEtaMax = fabs(etaCellMax - eta(iEtaMax) + 0.5 * m_deltaEtaTower) / aSegmentation->gridSizeEta();
+    if ((iEtaMax - iEtaMin - 1) != 0) {
+      fracEtaMiddle = (1 - fracEtaMin - fracEtaMax) / float(iEtaMax - iEtaMin - 1);
+    } else {
+      fracEtaMiddle = 0.0;
     }
-    fracPhiMin = 1.0;
-    fracPhiMax = 1.0;
-    fracPhiMiddle = 1.0;
-    if (iPhiMin != iPhiMax) {
-      fracPhiMin =
-          fabs(phi(iPhiMin) + 0.5 * m_deltaPhiTower - phiCellMin) / (2 * M_PI / (double)aSegmentation->phiBins());
-      fracPhiMax =
-          fabs(phiCellMax - phi(iPhiMax) + 0.5 * m_deltaPhiTower) / (2 * M_PI / (double)aSegmentation->phiBins());
-      if ((iPhiMax - iPhiMin - 1) != 0) {
-        fracPhiMiddle = (1 - fracPhiMin - fracPhiMax) / float(iPhiMax - iPhiMin - 1);
-      } else {
-        fracPhiMiddle = 0.0;
-      }
+  }
+  if (iPhiMin != iPhiMax) {
+    fracPhiMin =
+        fabs(phi(iPhiMin) + 0.5 * m_deltaPhiTower - phiCellMin) / (2 * M_PI / (double)aSegmentation->phiBins());
+    fracPhiMax =
+        fabs(phiCellMax - phi(iPhiMax) + 0.5 * m_deltaPhiTower) / (2 * M_PI / (double)aSegmentation->phiBins());
+    if ((iPhiMax - iPhiMin - 1) != 0) {
+      fracPhiMiddle = (1 - fracPhiMin - fracPhiMax) / float(iPhiMax - iPhiMin - 1);
+    } else {
+      fracPhiMiddle = 0.0;
     }
+  }
 
-    // Loop through the appropriate towers and add transverse energy
-    for (auto iEta = iEtaMin; iEta <= iEtaMax; iEta++) {
-      if (iEta == iEtaMin) {
-        ratioEta = fracEtaMin;
-      } else if (iEta == iEtaMax) {
-        ratioEta = fracEtaMax;
+  // Loop through the appropriate towers, the weight includes the conversion to transverse energy
+  const float transverseFactor = 1. / cosh(etaCell);
+  for (auto iEta = iEtaMin; iEta <= iEtaMax; iEta++) {
+    if (iEta == iEtaMin) {
+      ratioEta = fracEtaMin;
+    } else if (iEta == iEtaMax) {
+      ratioEta = fracEtaMax;
+    } else {
+      ratioEta = fracEtaMiddle;
+    }
+    for (auto iPhi = iPhiMin; iPhi <= iPhiMax; iPhi++) {
+      if (iPhi == iPhiMin) {
+        ratioPhi = fracPhiMin;
+      } else if (iPhi == iPhiMax) {
+        ratioPhi = fracPhiMax;
       } else {
-        ratioEta = fracEtaMiddle;
-      }
-      for (auto iPhi = iPhiMin; iPhi <= iPhiMax; iPhi++) {
-        if (iPhi == iPhiMin) {
-          ratioPhi = fracPhiMin;
-        } else if (iPhi == iPhiMax) {
-          ratioPhi = fracPhiMax;
-        } else {
-          ratioPhi = fracPhiMiddle;
-        }
-        aTowers[iEta][phiNeighbour(iPhi)] +=
-            cell.core().energy / cosh(aSegmentation->eta(cell.core().cellId)) * ratioEta * ratioPhi;
+        ratioPhi = fracPhiMiddle;
       }
+      aFractions.push_back({iEta * m_nPhiTower + phiNeighbour(iPhi), transverseFactor * ratioEta * ratioPhi});
     }
   }
 }
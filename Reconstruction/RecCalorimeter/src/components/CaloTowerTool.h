@@ -9,6 +9,8 @@
 #include "FWCore/DataHandle.h"
 #include "RecInterface/ITowerTool.h"
 
+#include <unordered_map>
+
 class IGeoSvc;
 
 // datamodel
@@ -34,6 +36,11 @@ class Segmentation;
  *  Distance in r plays no role, however `\b radiusForPosition` needs to be defined
  *  (e.g. to inner radius of the detector) for the cluster position calculation. By default the radius is equal to 1.
  *
+ *  The towers and fractions of the tower area covered by a cell depend only on the eta and phi bins of the cell.
+ *  They are calculated once per bin and readout (on the first cell found in that bin) and stored, together with the
+ *  conversion to transverse energy, in a table; towers are then built with a lookup and a scatter-add
+ *  into a flat eta x phi array.
+ *
  *  For more explanation please [see reconstruction documentation](@ref md_reconstruction_doc_reccalorimeter).
  *
  *  @author Anna Zaborowska
@@ -101,13 +108,36 @@ public:
    * (in [0, m_nPhiTower) range)
    */
   uint phiNeighbour(int aIPhi) const;
+  /// Contribution of a cell to a tower
+  struct TowerFraction {
+    /// Index of the tower in the flat array (iEta * m_nPhiTower + iPhi)
+    uint towerIndex;
+    /// Fraction of the cell area in the tower, divided by cosh(eta) of the cell
+    float weight;
+  };
+  /// Table of the towers of the cells of one readout, for each eta-phi bin
+  struct CellTowerTable {
+    /// Mask of the eta and phi fields of the cellID
+    uint64_t binMask = 0;
+    /// Range (first index, number) in fractions for each masked cellID
+    std::unordered_map<uint64_t, std::pair<uint, uint>> ranges;
+    /// Tower contributions of all bins
+    std::vector<TowerFraction> fractions;
+  };
   /**  This is where the cell info is filled into towers
-   *   @param[in] aTowers Calorimeter towers.
    *   @param[in] aCells Calorimeter cells collection.
    *   @param[in] aSegmentation Segmentation of the calorimeter
+   *   @param[in] aTable Table of the towers for the bins of the segmentation, completed with the new bins
+   */
+  void CellsIntoTowers(const fcc::CaloHitCollection* aCells, dd4hep::DDSegmentation::FCCSWGridPhiEta* aSegmentation,
+                       CellTowerTable& aTable);
+  /**  Calculate the towers of a cell, and the fractions of the cell area in them.
+   *   @param[in] aCellId cellID of the cell
+   *   @param[in] aSegmentation Segmentation of the calorimeter
+   *   @param[out] aFractions Vector to which the tower contributions are appended
    */
-  void CellsIntoTowers(std::vector<std::vector<float>>& aTowers, const fcc::CaloHitCollection* aCells,
-                       dd4hep::DDSegmentation::FCCSWGridPhiEta* aSegmentation);
+  void cellTowers(uint64_t aCellId, dd4hep::DDSegmentation::FCCSWGridPhiEta* aSegmentation,
+                  std::vector<TowerFraction>& aFractions) const;
   /**  Check if the readout name exists. If so, it returns the eta-phi segmentation.
    *   @param[in] aReadoutName Readout name to be retrieved
    */
@@ -165,6 +195,16 @@ private:
   dd4hep::DDSegmentation::FCCSWGridPhiEta* m_hcalEndcapSegmentation;
   /// PhiEta segmentation of the hcal forward calorimeter (owned by DD4hep)
   dd4hep::DDSegmentation::FCCSWGridPhiEta* m_hcalFwdSegmentation;
+  /// Tower tables of the calorimeter readouts (same order as the segmentations)
+  CellTowerTable m_ecalBarrelTowerTable;
+  CellTowerTable m_ecalEndcapTowerTable;
+  CellTowerTable m_ecalFwdTowerTable;
+  CellTowerTable m_hcalBarrelTowerTable;
+  CellTowerTable m_hcalExtBarrelTowerTable;
+  CellTowerTable m_hcalEndcapTowerTable;
+  CellTowerTable m_hcalFwdTowerTable;
+  /// Towers of the current event, flat array of m_nEtaTower x m_nPhiTower
+  std::vector<float> m_towers;
   /// Radius used to calculate cluster position from eta and phi (in mm)
   Gaudi::Property<double> m_radius{this, "radiusForPosition", 1.0,
                                    "Radius used to calculate cluster position from eta and phi (in mm)"};
@@ -51,11 +51,25 @@ StatusCode CreateCaloCells::initialize() {
       return StatusCode::FAILURE;
     }
     // Prepare map of all existing cells in calorimeter to add noise to all
-    StatusCode sc_prepareCells = m_geoTool->prepareEmptyCells(m_cellsMap);
+    std::unordered_map<uint64_t, double> cellsMap;
+    StatusCode sc_prepareCells = m_geoTool->prepareEmptyCells(cellsMap);
     if (sc_prepareCells.isFailure()) {
       error() << "Unable to create empty cells!" << endmsg;
       return StatusCode::FAILURE;
     }
+    // cells are stored in parallel arrays in the order of cellIDs
+    m_allCellIds.reserve(cellsMap.size());
+    for (const auto& cell : cellsMap) {
+      m_allCellIds.push_back(cell.first);
+    }
+    std::sort(m_allCellIds.begin(), m_allCellIds.end());
+    m_cellIndices.reserve(m_allCellIds.size());
+    for (uint iCell = 0; iCell < m_allCellIds.size(); iCell++) {
+      m_cellIndices.emplace(m_allCellIds[iCell], iCell);
+    }
+    m_allCellEnergies.assign(m_allCellIds.size(), 0);
+    m_cellGeneration.assign(m_allCellIds.size(), 0);
+    m_cellSlot.assign(m_allCellIds.size(), 0);
   }
   return StatusCode::SUCCESS;
 }
@@ -65,41 +79,56 @@ StatusCode CreateCaloCells::execute() {
   const fcc::CaloHitCollection* hits = m_hits.get();
   debug() << "Input Hit collection size: " << hits->size() << endmsg;
 
-  // 0. Clear all cells
-  if (m_addCellNoise) {
-    std::for_each(m_cellsMap.begin(), m_cellsMap.end(), [](std::pair<const uint64_t, double>& p) { p.second = 0; });
-  } else {
-    m_cellsMap.clear();
-  }
-
-  // 1. Merge energy deposits into cells
-  // If running with noise map already was prepared. Otherwise it is being
-  // created below
+  // 1. Merge energy deposits into cells: only the cells hit in this event, recognised by the event counter
+  m_generation++;
+  m_cellIds.clear();
+  m_cellEnergies.clear();
+  m_hitCellIndices.clear();
   for (const auto& hit : *hits) {
-    m_cellsMap[hit.core().cellId] += hit.core().energy;
+    uint index = cellIndex(hit.core().cellId);
+    if (m_cellGeneration[index] != m_generation) {
+      m_cellGeneration[index] = m_generation;
+      m_cellSlot[index] = m_cellIds.size();
+      m_cellIds.push_back(hit.core().cellId);
+      m_cellEnergies.push_back(0);
+      m_hitCellIndices.push_back(index);
+    }
+    m_cellEnergies[m_cellSlot[index]] += hit.core().energy;
   }
-  debug() << "Number of calorimeter cells after merging of hits: " << m_cellsMap.size() << endmsg;
+  debug() << "Number of calorimeter cells after merging of hits: " << m_cellIds.size() << endmsg;
 
-  // 2. Calibrate simulation energy to EM scale
+  // 2. Calibrate simulation energy to EM scale (cells without hits stay at zero)
   if (m_doCellCalibration) {
-    m_calibTool->calibrate(m_cellsMap);
+    m_calibTool->calibrate(m_cellIds, m_cellEnergies);
   }
 
-  // 3. Add noise to all cells
+  // 3. Add noise to all cells of the calorimeter, prepared in initialize()
+  const std::vector<uint64_t>* cellIds = &m_cellIds;
+  const std::vector<double>* cellEnergies = &m_cellEnergies;
   if (m_addCellNoise) {
-    m_noiseTool->addRandomCellNoise(m_cellsMap);
+    std::fill(m_allCellEnergies.begin(), m_allCellEnergies.end(), 0);
+    for (uint iCell = 0; iCell < m_cellIds.size(); iCell++) {
+      m_allCellEnergies[m_hitCellIndices[iCell]] = m_cellEnergies[iCell];
+    }
+    m_noiseTool->addRandomCellNoise(m_allCellIds, m_allCellEnergies);
+    cellIds = &m_allCellIds;
+    cellEnergies = &m_allCellEnergies;
     if (m_filterCellNoise) {
-      m_noiseTool->filterCellNoise(m_cellsMap);
+      // only the cells above threshold are copied
+      m_noiseTool->filterCellNoise(m_allCellIds, m_allCellEnergies, m_filteredCellIds, m_filteredCellEnergies);
+      cellIds = &m_filteredCellIds;
+      cellEnergies = &m_filteredCellEnergies;
     }
   }
 
   // 4. Copy information to CaloHitCollection
   fcc::CaloHitCollection* edmCellsCollection = new fcc::CaloHitCollection();
-  for (const auto& cell : m_cellsMap) {
-    if (m_addCellNoise || (!m_addCellNoise && cell.second != 0)) {
+  for (uint iCell = 0; iCell < cellIds->size(); iCell++) {
+    double energy = (*cellEnergies)[iCell];
+    if (m_addCellNoise || energy != 0) {
       fcc::CaloHit newCell = edmCellsCollection->create();
-      newCell.core().energy = cell.second;
-      newCell.core().cellId = cell.first;
+      newCell.core().energy = energy;
+      newCell.core().cellId = (*cellIds)[iCell];
     }
   }
 
@@ -111,3 +140,17 @@ StatusCode CreateCaloCells::execute() {
 }
 
 StatusCode CreateCaloCells::finalize() { return GaudiAlgorithm::finalize(); }
+
+uint CreateCaloCells::cellIndex(uint64_t aCellId) {
+  auto it = m_cellIndices.find(aCellId);
+  if (it != m_cellIndices.end()) {
+    return it->second;
+  }
+  uint index = m_allCellIds.size();
+  m_cellIndices.emplace(aCellId, index);
+  m_allCellIds.push_back(aCellId);
+  m_allCellEnergies.push_back(0);
+  m_cellGeneration.push_back(0);
+  m_cellSlot.push_back(0);
+  return index;
+}
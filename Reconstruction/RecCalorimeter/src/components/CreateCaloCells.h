@@ -98,8 +98,30 @@ private:
 
   /// Pointer to the geometry service
   SmartIF<IGeoSvc> m_geoSvc;
-  /// Map of cell IDs (corresponding to DD4hep IDs) and energy
-  std::unordered_map<uint64_t, double> m_cellsMap;
+  /// Index of a cellID in the persistent arrays below, a new cellID is appended
+  uint cellIndex(uint64_t aCellId);
+  /// Map of cell IDs (corresponding to DD4hep IDs) to their index in the persistent arrays
+  std::unordered_map<uint64_t, uint> m_cellIndices;
+  /// CellIDs of all known cells (all cells of the calorimeter if noise is added)
+  std::vector<uint64_t> m_allCellIds;
+  /// Energy of all known cells (used if noise is added)
+  std::vector<double> m_allCellEnergies;
+  /// Event in which a known cell was last hit
+  std::vector<uint> m_cellGeneration;
+  /// Position of a known cell in the arrays of the current event (valid if hit in the current event)
+  std::vector<uint> m_cellSlot;
+  /// Counter of the events, used to recognise the cells already hit in the current event
+  uint m_generation = 0;
+  /// CellIDs of the cells hit in the current event
+  std::vector<uint64_t> m_cellIds;
+  /// Energies of the cells hit in the current event
+  std::vector<double> m_cellEnergies;
+  /// Index in the persistent arrays of the cells hit in the current event
+  std::vector<uint> m_hitCellIndices;
+  /// CellIDs of the cells above the noise threshold in the current event (used if noise is filtered)
+  std::vector<uint64_t> m_filteredCellIds;
+  /// Energies of the cells above the noise threshold in the current event (used if noise is filtered)
+  std::vector<double> m_filteredCellEnergies;
 };
 
 #endif /* RECCALORIMETER_CREATECALOCELLS_H */
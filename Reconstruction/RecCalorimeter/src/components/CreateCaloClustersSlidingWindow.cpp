@@ -33,6 +33,14 @@ StatusCode CreateCaloClustersSlidingWindow::initialize() {
             << endmsg;
     m_nEtaTower = m_nEtaWindow;
   }
+  m_sumAreaTable.assign((m_nEtaTower + 1) * (m_nPhiTower + 1), 0);
+  m_etaPrefix.assign((m_nEtaTower + 1) * m_nPhiTower, 0);
+  m_phiPrefix.assign(m_nEtaTower * (m_nPhiTower + 1), 0);
+  m_towerCoverage.assign(m_nEtaTower * m_nPhiTower, 0);
+  // buckets of the duplicates window size: duplicates can only be found in the neighbouring buckets
+  m_nEtaBuckets = (m_nEtaTower + std::max(1, m_nEtaDuplicates.value()) - 1) / std::max(1, m_nEtaDuplicates.value());
+  m_nPhiBuckets = (m_nPhiTower + std::max(1, m_nPhiDuplicates.value()) - 1) / std::max(1, m_nPhiDuplicates.value());
+  m_preClusterGrid.assign(m_nEtaBuckets * m_nPhiBuckets, std::vector<unsigned int>());
   info() << "CreateCaloClustersSlidingWindow initialized" << endmsg;
   return StatusCode::SUCCESS;
 }
@@ -48,15 +56,10 @@ StatusCode CreateCaloClustersSlidingWindow::execute() {
     return StatusCode::SUCCESS;
   }
   // 2. Find local maxima with sliding window, build preclusters, calculate their barycentre position
-  // calculate the sum of first m_nEtaWindow bins in eta, for each phi tower
-  std::vector<float> sumOverEta(m_nPhiTower, 0);
-  for (int iEta = 0; iEta < m_nEtaWindow; iEta++) {
-    std::transform(sumOverEta.begin(), sumOverEta.end(), m_towers[iEta].begin(), sumOverEta.begin(),
-                   std::plus<float>());
-  }
+  buildSumTables();
 
   // preclusters with phi, eta weighted position and transverse energy
-  std::vector<cluster> m_preClusters;
+  m_preClusters.clear();
   int halfEtaPos = floor(m_nEtaPosition / 2.);
   int halfPhiPos = floor(m_nPhiPosition / 2.);
   float posEta = 0;
@@ -73,58 +76,41 @@ StatusCode CreateCaloClustersSlidingWindow::execute() {
   // loop over all Eta slices starting at the half of the first window
   int halfEtaWin = floor(m_nEtaWindow / 2.);
   int halfPhiWin = floor(m_nPhiWindow / 2.);
+  int phiWidthWin = 2 * halfPhiWin + 1;
   float sumWindow = 0;
-  float sumPhiSlicePrevEtaWin = 0;
-  float sumPhiSliceNextEtaWin = 0;
-  float sumFirstPhiSlice = 0;
-  float sumLastPhiSlice = 0;
   bool toRemove = false;
-  // one slice in eta = window, now only sum over window elements in phi
   for (int iEta = halfEtaWin; iEta < m_nEtaTower - halfEtaWin; iEta++) {
-    // sum the first window in phi
-    for (int iPhiWindow = -halfPhiWin; iPhiWindow <= halfPhiWin; iPhiWindow++) {
-      sumWindow += sumOverEta[phiNeighbour(iPhiWindow)];
-    }
     // loop over all the phi slices
     for (int iPhi = 0; iPhi < m_nPhiTower; iPhi++) {
+      sumWindow = windowSum(iEta - halfEtaWin, iEta + halfEtaWin, iPhi - halfPhiWin, phiWidthWin);
       // if energy is above threshold, it may be a precluster
       if (sumWindow > m_energyThreshold) {
         // test local maximum in phi
         // check closest neighbour on the right
-        if (sumOverEta[phiNeighbour(iPhi - halfPhiWin)] < sumOverEta[phiNeighbour(iPhi + halfPhiWin + 1)]) {
+        if (etaSliceSum(iEta - halfEtaWin, iEta + halfEtaWin, iPhi - halfPhiWin) <
+            etaSliceSum(iEta - halfEtaWin, iEta + halfEtaWin, iPhi + halfPhiWin + 1)) {
           toRemove = true;
         }
         // check closest neighbour on the left
-        if (sumOverEta[phiNeighbour(iPhi + halfPhiWin)] < sumOverEta[phiNeighbour(iPhi - halfPhiWin - 1)]) {
+        if (etaSliceSum(iEta - halfEtaWin, iEta + halfEtaWin, iPhi + halfPhiWin) <
+            etaSliceSum(iEta - halfEtaWin, iEta + halfEtaWin, iPhi - halfPhiWin - 1)) {
           toRemove = true;
         }
         // test local maximum in eta
         // check closest neighbour on the right (if it is not the first window)
         if (iEta > halfEtaWin) {
-          for (int iPhiWindowLocalCheck = iPhi - halfPhiWin; iPhiWindowLocalCheck <= iPhi + halfPhiWin;
-               iPhiWindowLocalCheck++) {
-            sumPhiSlicePrevEtaWin += m_towers[iEta - halfEtaWin - 1][phiNeighbour(iPhiWindowLocalCheck)];
-            sumLastPhiSlice += m_towers[iEta + halfEtaWin][phiNeighbour(iPhiWindowLocalCheck)];
-          }
-          if (sumPhiSlicePrevEtaWin > sumLastPhiSlice) {
+          if (phiSliceSum(iEta - halfEtaWin - 1, iPhi - halfPhiWin, phiWidthWin) >
+              phiSliceSum(iEta + halfEtaWin, iPhi - halfPhiWin, phiWidthWin)) {
             toRemove = true;
           }
         }
         // check closest neighbour on the left (if it is not the last window)
         if (iEta < m_nEtaTower - halfEtaWin - 1) {
-          for (int iPhiWindowLocalCheck = iPhi - halfPhiWin; iPhiWindowLocalCheck <= iPhi + halfPhiWin;
-               iPhiWindowLocalCheck++) {
-            sumPhiSliceNextEtaWin += m_towers[iEta + halfEtaWin + 1][phiNeighbour(iPhiWindowLocalCheck)];
-            sumFirstPhiSlice += m_towers[iEta - halfEtaWin][phiNeighbour(iPhiWindowLocalCheck)];
-          }
-          if (sumPhiSliceNextEtaWin > sumFirstPhiSlice) {
+          if (phiSliceSum(iEta + halfEtaWin + 1, iPhi - halfPhiWin, phiWidthWin) >
+              phiSliceSum(iEta - halfEtaWin, iPhi - halfPhiWin, phiWidthWin)) {
             toRemove = true;
           }
         }
-        sumFirstPhiSlice = 0;
-        sumLastPhiSlice = 0;
-        sumPhiSlicePrevEtaWin = 0;
-        sumPhiSliceNextEtaWin = 0;
         // Build precluster
         if (!toRemove) {
           // Calculate barycentre position (usually smaller window used to reduce noise influence)
@@ -161,19 +147,12 @@ StatusCode CreateCaloClustersSlidingWindow::execute() {
           if (fabs(posPhi) > M_PI) {
             posPhi += -2 * M_PI * posPhi / fabs(posPhi);
           }
-          // Calculate final cluster energy
-          sumEnergyFin = 0;
           // Final cluster position
           idEtaFin = m_towerTool->idEta(posEta);
           idPhiFin = m_towerTool->idPhi(posPhi);
           // Recalculating the energy within the final cluster size
-          for (int ipEta = idEtaFin - halfEtaFin; ipEta <= idEtaFin + halfEtaFin; ipEta++) {
-            for (int ipPhi = idPhiFin - halfPhiFin; ipPhi <= idPhiFin + halfPhiFin; ipPhi++) {
-              if (ipEta >= 0 && ipEta < m_nEtaTower) {  // check if we are not outside of map in eta
-                sumEnergyFin += m_towers[ipEta][phiNeighbour(ipPhi)];
-              }
-            }
-          }
+          sumEnergyFin = windowSum(idEtaFin - halfEtaFin, idEtaFin + halfEtaFin, idPhiFin - halfPhiFin,
+                                   2 * halfPhiFin + 1);
           // check if changing the barycentre did not decrease energy below threshold
           if (sumEnergyFin > m_energyThreshold) {
             cluster newPreCluster;
@@ -185,21 +164,6 @@ StatusCode CreateCaloClustersSlidingWindow::execute() {
         }
       }
       toRemove = false;
-      // finish processing that window in phi, shift window to the next phi tower
-      // substract first phi tower in current window
-      sumWindow -= sumOverEta[phiNeighbour(iPhi - halfPhiWin)];
-      // add next phi tower to the window
-      sumWindow += sumOverEta[phiNeighbour(iPhi + halfPhiWin + 1)];
-    }
-    sumWindow = 0;
-    // finish processing that slice, shift window to next eta tower
-    if (iEta < m_nEtaTower - halfEtaWin - 1) {
-      // substract first eta slice in current window
-      std::transform(sumOverEta.begin(), sumOverEta.end(), m_towers[iEta - halfEtaWin].begin(), sumOverEta.begin(),
-                     std::minus<float>());
-      // add next eta slice to the window
-      std::transform(sumOverEta.begin(), sumOverEta.end(), m_towers[iEta + halfEtaWin + 1].begin(), sumOverEta.begin(),
-                     std::plus<float>());
     }
   }
 
@@ -210,19 +174,23 @@ StatusCode CreateCaloClustersSlidingWindow::execute() {
             [](cluster clu1, cluster clu2) { return clu1.transEnergy > clu2.transEnergy; });
 
   // 5. Remove duplicates
-  for (auto it1 = m_preClusters.begin(); it1 != m_preClusters.end(); it1++) {
-    // loop over all clusters with energy lower than it1 (sorting), erase if too close
-    for (auto it2 = it1 + 1; it2 != m_preClusters.end();) {
-      if ((abs(m_towerTool->idEta((*it1).eta) - m_towerTool->idEta((*it2).eta)) < m_nEtaDuplicates) &&
-          ((abs(m_towerTool->idPhi((*it1).phi) - m_towerTool->idPhi((*it2).phi)) < m_nPhiDuplicates) ||
-           (abs(m_towerTool->idPhi((*it1).phi) - m_towerTool->idPhi((*it2).phi)) > m_nPhiTower - m_nPhiDuplicates))) {
-        m_preClusters.erase(it2);
-      } else {
-        it2++;
+  removeDuplicates();
+  debug() << "Pre-clusters size after duplicates removal: " << m_preClusters.size() << endmsg;
+
+  // count the final windows covering each tower, for the energy sharing correction
+  if (m_energySharingCorrection) {
+    std::fill(m_towerCoverage.begin(), m_towerCoverage.end(), 0);
+    for (const auto& clu : m_preClusters) {
+      int idEtaCl = m_towerTool->idEta(clu.eta);
+      int idPhiCl = m_towerTool->idPhi(clu.phi);
+      for (int iEta = std::max(0, idEtaCl - halfEtaFin); iEta <= std::min(m_nEtaTower - 1, idEtaCl + halfEtaFin);
+           iEta++) {
+        for (int iPhi = idPhiCl - halfPhiFin; iPhi <= idPhiCl + halfPhiFin; iPhi++) {
+          m_towerCoverage[iEta * m_nPhiTower + phiNeighbour(iPhi)]++;
+        }
       }
     }
   }
-  debug() << "Pre-clusters size after duplicates removal: " << m_preClusters.size() << endmsg;
 
   // 6. Create final clusters
   // currently only role of r is to calculate x,y,z position
@@ -233,39 +201,14 @@ StatusCode CreateCaloClustersSlidingWindow::execute() {
     if (m_energySharingCorrection) {
       int idEtaCl = m_towerTool->idEta(clu.eta);
       int idPhiCl = m_towerTool->idPhi(clu.phi);
-      // sum of energies in other clusters in each eta-phi tower of our current cluster (idEtaCl, idPhiCl)
-      std::vector<std::vector<float>> sumEnergySharing;
-      sumEnergySharing.assign(m_nEtaFinal, std::vector<float>(m_nPhiFinal, 0));
-      // loop over all clusters and check if they have any tower in common with our current cluster
-      for (const auto cluSharing : m_preClusters) {
-        int idEtaClShare = m_towerTool->idEta(cluSharing.eta);
-        int idPhiClShare = m_towerTool->idPhi(cluSharing.phi);
-        if (idEtaCl != idEtaClShare && idPhiCl != idPhiClShare) {
-          // check for overlap between clusters
-          if (abs(idEtaClShare - idEtaCl) < m_nEtaFinal &&
-              ((abs(idPhiClShare - idPhiCl) < m_nPhiFinal) ||
-               (abs(idPhiClShare - idPhiCl) > m_nPhiTower - m_nPhiFinal))) {
-            // add energy in shared towers to sumEnergySharing[][]
-            for (int iEta = std::max(idEtaCl, idEtaClShare) - halfEtaFin;
-                 iEta <= std::min(idEtaCl, idEtaClShare) + halfEtaFin; iEta++) {
-              for (int iPhi = std::max(idPhiCl, idPhiClShare) - halfPhiFin;
-                   iEta <= std::min(idPhiCl, idPhiClShare) + halfPhiFin; iPhi++) {
-                if (iEta >= 0 && iEta < m_nEtaTower) {  // check if we are not outside of map in eta
-                  sumEnergySharing[iEta - idEtaCl + halfEtaFin][iPhi - idPhiCl + halfPhiFin] +=
-                      m_towers[iEta][phiNeighbour(iPhi)] * cosh(m_towerTool->eta(iEta));
-                }
-              }
-            }
-          }
-        }
-      }
-      // apply the actual correction: substract the weighted energy contributions in other clusters
-      for (int iEta = idEtaCl - halfEtaFin; iEta <= idEtaCl + halfEtaFin; iEta++) {
+      // towers shared with other clusters contribute only their share of the energy: E / (number of clusters)
+      for (int iEta = std::max(0, idEtaCl - halfEtaFin); iEta <= std::min(m_nEtaTower - 1, idEtaCl + halfEtaFin);
+           iEta++) {
         for (int iPhi = idPhiCl - halfPhiFin; iPhi <= idPhiCl + halfPhiFin; iPhi++) {
-          if (sumEnergySharing[iEta - idEtaCl + halfEtaFin][iPhi - idPhiCl + halfPhiFin] != 0) {
-            float sumButOne = sumEnergySharing[iEta - idEtaCl + halfEtaFin][iPhi - idPhiCl + halfPhiFin];
+          unsigned int numSharing = m_towerCoverage[iEta * m_nPhiTower + phiNeighbour(iPhi)];
+          if (numSharing > 1) {
             float towerEnergy = m_towers[iEta][phiNeighbour(iPhi)] * cosh(m_towerTool->eta(iEta));
-            clusterEnergy -= towerEnergy * sumButOne / (sumButOne + towerEnergy);
+            clusterEnergy -= towerEnergy * (numSharing - 1) / numSharing;
           }
         }
       }
@@ -297,3 +240,100 @@ unsigned int CreateCaloClustersSlidingWindow::phiNeighbour(int aIPhi) const {
   }
   return aIPhi;
 }
+
+void CreateCaloClustersSlidingWindow::buildSumTables() {
+  const int stride = m_nPhiTower + 1;
+  for (int iEta = 0; iEta < m_nEtaTower; iEta++) {
+    const auto& towersEta = m_towers[iEta];
+    double* phiPrefix = &m_phiPrefix[iEta * stride];
+    const double* etaPrefixPrev = &m_etaPrefix[iEta * m_nPhiTower];
+    double* etaPrefix = &m_etaPrefix[(iEta + 1) * m_nPhiTower];
+    const double* sumAreaPrev = &m_sumAreaTable[iEta * stride];
+    double* sumArea = &m_sumAreaTable[(iEta + 1) * stride];
+    for (int iPhi = 0; iPhi < m_nPhiTower; iPhi++) {
+      phiPrefix[iPhi + 1] = phiPrefix[iPhi] + towersEta[iPhi];
+      etaPrefix[iPhi] = etaPrefixPrev[iPhi] + towersEta[iPhi];
+      sumArea[iPhi + 1] = sumAreaPrev[iPhi + 1] + phiPrefix[iPhi + 1];
+    }
+  }
+}
+
+double CreateCaloClustersSlidingWindow::phiRangeSum(const double* aPrefix, int aPhiStart, int aPhiWidth) const {
+  int start = aPhiStart % m_nPhiTower;
+  if (start < 0) {
+    start += m_nPhiTower;
+  }
+  // windows wider than the full coverage count towers more than once, as the explicit sum over the window does
+  double sum = (aPhiWidth / m_nPhiTower) * aPrefix[m_nPhiTower];
+  int end = start + aPhiWidth % m_nPhiTower;
+  if (end <= m_nPhiTower) {
+    sum += aPrefix[end] - aPrefix[start];
+  } else {
+    sum += aPrefix[m_nPhiTower] - aPrefix[start] + aPrefix[end - m_nPhiTower];
+  }
+  return sum;
+}
+
+double CreateCaloClustersSlidingWindow::windowSum(int aEtaMin, int aEtaMax, int aPhiStart, int aPhiWidth) const {
+  aEtaMin = std::max(aEtaMin, 0);
+  aEtaMax = std::min(aEtaMax, m_nEtaTower - 1);
+  if (aEtaMin > aEtaMax) {
+    return 0;
+  }
+  const int stride = m_nPhiTower + 1;
+  return phiRangeSum(&m_sumAreaTable[(aEtaMax + 1) * stride], aPhiStart, aPhiWidth) -
+         phiRangeSum(&m_sumAreaTable[aEtaMin * stride], aPhiStart, aPhiWidth);
+}
+
+double CreateCaloClustersSlidingWindow::etaSliceSum(int aEtaMin, int aEtaMax, int aPhi) const {
+  unsigned int iPhi = phiNeighbour(aPhi);
+  return m_etaPrefix[(aEtaMax + 1) * m_nPhiTower + iPhi] - m_etaPrefix[aEtaMin * m_nPhiTower + iPhi];
+}
+
+double CreateCaloClustersSlidingWindow::phiSliceSum(int aEta, int aPhiStart, int aPhiWidth) const {
+  return phiRangeSum(&m_phiPrefix[aEta * (m_nPhiTower + 1)], aPhiStart, aPhiWidth);
+}
+
+void CreateCaloClustersSlidingWindow::removeDuplicates() {
+  const int etaBucketSize = std::max(1, m_nEtaDuplicates.value());
+  const int phiBucketSize = std::max(1, m_nPhiDuplicates.value());
+  for (auto& bucket : m_preClusterGrid) {
+    bucket.clear();
+  }
+  // pre-clusters are sorted in energy: one is kept if no kept pre-cluster (of higher energy) is within the window
+  unsigned int numKept = 0;
+  for (unsigned int iCluster = 0; iCluster < m_preClusters.size(); iCluster++) {
+    const cluster clu = m_preClusters[iCluster];
+    int idEtaCl = m_towerTool->idEta(clu.eta);
+    int idPhiCl = m_towerTool->idPhi(clu.phi);
+    int idEtaBucket = std::min(std::max(idEtaCl, 0), m_nEtaTower - 1);
+    bool duplicate = false;
+    for (int iEtaBucket = std::max(idEtaBucket - etaBucketSize + 1, 0) / etaBucketSize;
+         !duplicate && iEtaBucket <= std::min(idEtaBucket + etaBucketSize - 1, m_nEtaTower - 1) / etaBucketSize;
+         iEtaBucket++) {
+      int previousPhiBucket = -1;
+      for (int iPhi = idPhiCl - phiBucketSize + 1; !duplicate && iPhi <= idPhiCl + phiBucketSize - 1; iPhi++) {
+        int iPhiBucket = phiNeighbour(iPhi) / phiBucketSize;
+        if (iPhiBucket == previousPhiBucket) {
+          continue;
+        }
+        previousPhiBucket = iPhiBucket;
+        for (auto iKept : m_preClusterGrid[iEtaBucket * m_nPhiBuckets + iPhiBucket]) {
+          int deltaEta = abs(idEtaCl - int(m_towerTool->idEta(m_preClusters[iKept].eta)));
+          int deltaPhi = abs(idPhiCl - int(m_towerTool->idPhi(m_preClusters[iKept].phi)));
+          if (deltaEta < m_nEtaDuplicates &&
+              (deltaPhi < m_nPhiDuplicates || deltaPhi > m_nPhiTower - m_nPhiDuplicates)) {
+            duplicate = true;
+            break;
+          }
+        }
+      }
+    }
+    if (!duplicate) {
+      m_preClusterGrid[(idEtaBucket / etaBucketSize) * m_nPhiBuckets + phiNeighbour(idPhiCl) / phiBucketSize]
+          .push_back(numKept);
+      m_preClusters[numKept++] = clu;
+    }
+  }
+  m_preClusters.resize(numKept);
+}
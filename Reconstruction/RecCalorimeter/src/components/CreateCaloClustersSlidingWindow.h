@@ -46,15 +46,20 @@ struct cluster {
  *  3. Remove duplicates.
  *     If two pre-clusters are found next to each other (within window '\b nEtaDuplicates', '\b nPhiDuplicates'), the
  *pre-cluster with lower energy is removed.
- *     Currently there is no support on energy sharing between clusters, so if duplicate window is smaller than
- *sliding window, some towers may be taken twice (instead of the weighted energy).
+ *     Pre-clusters are stored in an eta-phi grid of buckets of the duplicate window size, so only pre-clusters in
+ *neighbouring buckets are compared.
  *  4. Build clusters.
  *     Clusters are created using the window of a fixed size in phi x eta ('\b nEtaFinal' '\b nPhiFinal' in units of
  *tower size) around the barycentre position.
  *     Position is calculated from the barycentre position and the radius of the detector.
  *     Radius may be defined by user ('\b radiusForPosition') or (if not defined) taken from det::utils::tubeDimensions.
  *     The second approach may be used for sensitive cylindrical geometries.
- *     For each cluster the cell collection is searched and all those inside the cluster are attached.
+ *     If '\b energySharingCorrection' is set, the energy of a tower covered by the final windows of several clusters
+ *is shared equally between them.
+ *
+ *  All window sums are calculated in constant time from prefix sums of the tower energies (a summed-area table, and
+ *one-dimensional prefix sums in eta and in phi), taking into account the full coverage in phi.
+ *  Windows extend over 2 * floor(n / 2) + 1 towers, so odd window sizes are expected.
  *
  *  Note: Sliding window performs well for electrons/gamma reconstruction. Topological clusters should be better for
  *jets.
@@ -88,6 +93,29 @@ private:
    *   @return  ID of a tower - shifted and corrected (in [0, m_nPhiTower) range)
    */
   unsigned int phiNeighbour(int aIPhi) const;
+  /// Fill the prefix sums of the tower energies, used for all window sums
+  void buildSumTables();
+  /**  Sum over a range of phi towers from a prefix sum over phi, taking into account the full coverage in phi.
+   *   @param[in] aPrefix prefix sum (m_nPhiTower + 1 entries, first one is 0)
+   *   @param[in] aPhiStart ID of the first phi tower, may be < 0 or >= m_nPhiTower
+   *   @param[in] aPhiWidth number of phi towers
+   *   @return sum over the range
+   */
+  double phiRangeSum(const double* aPrefix, int aPhiStart, int aPhiWidth) const;
+  /**  Sum of the tower energies in a window.
+   *   @param[in] aEtaMin ID of the first eta tower (window is cut to the tower map in eta)
+   *   @param[in] aEtaMax ID of the last eta tower (included)
+   *   @param[in] aPhiStart ID of the first phi tower, may be < 0 or >= m_nPhiTower
+   *   @param[in] aPhiWidth number of phi towers
+   *   @return sum of the transverse energy
+   */
+  double windowSum(int aEtaMin, int aEtaMax, int aPhiStart, int aPhiWidth) const;
+  /// Sum of the tower energies in one phi tower, over eta towers [aEtaMin, aEtaMax]
+  double etaSliceSum(int aEtaMin, int aEtaMax, int aPhi) const;
+  /// Sum of the tower energies in one eta tower, over aPhiWidth phi towers starting at aPhiStart
+  double phiSliceSum(int aEta, int aPhiStart, int aPhiWidth) const;
+  /// Remove the pre-clusters that are close to a pre-cluster of higher energy
+  void removeDuplicates();
   /// Handle for calo clusters (output collection)
   DataHandle<fcc::CaloClusterCollection> m_clusters{"calo/clusters", Gaudi::DataHandle::Writer, this};
   /// Handle for the tower building tool
@@ -96,6 +124,20 @@ private:
   std::vector<std::vector<float>> m_towers;
   /// Vector of pre-clusters
   std::vector<cluster> m_preClusters;
+  /// Summed-area table of the towers: sum over eta IDs < iEta and phi IDs < iPhi, (m_nEtaTower + 1) x (m_nPhiTower + 1)
+  std::vector<double> m_sumAreaTable;
+  /// Prefix sums in eta of each phi tower: sum over eta IDs < iEta, (m_nEtaTower + 1) x m_nPhiTower
+  std::vector<double> m_etaPrefix;
+  /// Prefix sums in phi of each eta tower: sum over phi IDs < iPhi, m_nEtaTower x (m_nPhiTower + 1)
+  std::vector<double> m_phiPrefix;
+  /// Number of final cluster windows covering each tower, m_nEtaTower x m_nPhiTower
+  std::vector<unsigned int> m_towerCoverage;
+  /// Indices of the kept pre-clusters in each eta-phi bucket of the duplicate window size
+  std::vector<std::vector<unsigned int>> m_preClusterGrid;
+  /// Number of buckets of m_preClusterGrid in eta
+  int m_nEtaBuckets;
+  /// Number of buckets of m_preClusterGrid in phi
+  int m_nPhiBuckets;
   /// number of towers in eta (calculated from m_deltaEtaTower and the eta size of the first layer)
   int m_nEtaTower;
   /// Number of towers in phi (calculated from m_deltaPhiTower)
@@ -40,4 +40,29 @@ void NoiseCaloCellsFlatTool::filterCellNoise(std::unordered_map<uint64_t, double
   }
 }
 
+void NoiseCaloCellsFlatTool::addRandomCellNoise(const std::vector<uint64_t>&, std::vector<double>& aEnergies) {
+  if (m_gauss.shootArray(m_randomNumbers, aEnergies.size()).isFailure()) {
+    error() << "Couldn't generate random numbers, no noise added to the cells" << endmsg;
+    return;
+  }
+  for (size_t iCell = 0; iCell < aEnergies.size(); iCell++) {
+    aEnergies[iCell] += m_randomNumbers[iCell] * m_cellNoise;
+  }
+}
+
+void NoiseCaloCellsFlatTool::filterCellNoise(const std::vector<uint64_t>& aCellIds,
+                                             const std::vector<double>& aEnergies, std::vector<uint64_t>& aKeptCellIds,
+                                             std::vector<double>& aKeptEnergies) {
+  // Copy only the cells with energy above a threshold
+  double threshold = m_filterThreshold * m_cellNoise;
+  aKeptCellIds.clear();
+  aKeptEnergies.clear();
+  for (size_t iCell = 0; iCell < aEnergies.size(); iCell++) {
+    if (!(aEnergies[iCell] < threshold)) {
+      aKeptCellIds.push_back(aCellIds[iCell]);
+      aKeptEnergies.push_back(aEnergies[iCell]);
+    }
+  }
+}
+
 StatusCode NoiseCaloCellsFlatTool::finalize() { return GaudiTool::finalize(); }
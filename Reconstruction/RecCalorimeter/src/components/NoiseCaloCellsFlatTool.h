@@ -34,6 +34,14 @@ public:
   /** @brief Remove cells with energy bellow threshold*sigma from the vector of cells
    */
   virtual void filterCellNoise(std::unordered_map<uint64_t, double>& aCells) final;
+  /** @brief Add random noise to the cells stored in parallel arrays of cellIDs and energies
+   */
+  virtual void addRandomCellNoise(const std::vector<uint64_t>& aCellIds, std::vector<double>& aEnergies) final;
+  /** @brief Copy the cells with energy above threshold*sigma from the parallel arrays of cellIDs and energies
+   *  to the output arrays
+   */
+  virtual void filterCellNoise(const std::vector<uint64_t>& aCellIds, const std::vector<double>& aEnergies,
+                               std::vector<uint64_t>& aKeptCellIds, std::vector<double>& aKeptEnergies) final;
 
 private:
   /// Sigma of noise -- uniform noise per cell in GeV
@@ -46,6 +54,8 @@ private:
   IRndmGenSvc* m_randSvc;
   /// Gaussian random number generator used for smearing with a constant resolution (m_sigma)
   Rndm::Numbers m_gauss;
+  /// Buffer of standard normal random numbers, one per cell
+  std::vector<double> m_randomNumbers;
 };
 
 #endif /* RECCALORIMETER_NOISECALOCELLSFLATTOOL_H */
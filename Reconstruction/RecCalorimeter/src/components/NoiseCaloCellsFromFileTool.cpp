@@ -12,6 +12,8 @@
 #include "TH1F.h"
 #include "TMath.h"
 
+#include <algorithm>
+
 DECLARE_TOOL_FACTORY(NoiseCaloCellsFromFileTool)
 
 NoiseCaloCellsFromFileTool::NoiseCaloCellsFromFileTool(const std::string& type, const std::string& name,
@@ -48,6 +50,8 @@ StatusCode NoiseCaloCellsFromFileTool::initialize() {
     error() << "There is no phi-eta segmentation." << endmsg;
     return StatusCode::FAILURE;
   }
+  // Take readout, bitfield from GeoSvc
+  m_decoder = m_geoSvc->lcdd()->readout(m_readoutName).idSpec().decoder();
 
   debug() << "Filter noise threshold: " << m_filterThreshold << "*sigma" << endmsg;
 
@@ -58,21 +62,90 @@ StatusCode NoiseCaloCellsFromFileTool::initialize() {
 }
 
 void NoiseCaloCellsFromFileTool::addRandomCellNoise(std::unordered_map<uint64_t, double>& aCells) {
-  std::for_each(aCells.begin(), aCells.end(), [this](std::pair<const uint64_t, double>& p) {
-    p.second += (getNoiseConstantPerCell(p.first) * m_gauss.shoot());
-  });
+  // the first call gets all cells of the calorimeter
+  if (m_tableCellIds.empty()) {
+    std::vector<uint64_t> cellIds;
+    cellIds.reserve(aCells.size());
+    for (const auto& cell : aCells) {
+      cellIds.push_back(cell.first);
+    }
+    fillNoiseTable(std::move(cellIds));
+  }
+  // random numbers generated in one go for all cells
+  if (m_gauss.shootArray(m_randomNumbers, aCells.size()).isFailure()) {
+    error() << "Couldn't generate random numbers, no noise added to the cells" << endmsg;
+    return;
+  }
+  auto randomNumber = m_randomNumbers.begin();
+  for (auto& cell : aCells) {
+    cell.second += noiseConstant(cell.first, m_tableCellIds.size()) * (*randomNumber);
+    ++randomNumber;
+  }
 }
 
 void NoiseCaloCellsFromFileTool::filterCellNoise(std::unordered_map<uint64_t, double>& aCells) {
   // Erase a cell if it has energy bellow a threshold from the vector
-  auto it = aCells.begin();
-  while ((it = std::find_if(it, aCells.end(), [this](std::pair<const uint64_t, double>& p) {
-            return bool(p.second < m_filterThreshold * getNoiseConstantPerCell(p.first));
-          })) != aCells.end()) {
-    aCells.erase(it++);
+  for (auto it = aCells.begin(); it != aCells.end();) {
+    if (it->second < m_filterThreshold * noiseConstant(it->first, m_tableCellIds.size())) {
+      it = aCells.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void NoiseCaloCellsFromFileTool::addRandomCellNoise(const std::vector<uint64_t>& aCellIds,
+                                                    std::vector<double>& aEnergies) {
+  if (m_tableCellIds.empty()) {
+    fillNoiseTable(aCellIds);
+  }
+  if (m_gauss.shootArray(m_randomNumbers, aCellIds.size()).isFailure()) {
+    error() << "Couldn't generate random numbers, no noise added to the cells" << endmsg;
+    return;
+  }
+  for (size_t iCell = 0; iCell < aCellIds.size(); iCell++) {
+    aEnergies[iCell] += noiseConstant(aCellIds[iCell], iCell) * m_randomNumbers[iCell];
   }
 }
 
+void NoiseCaloCellsFromFileTool::filterCellNoise(const std::vector<uint64_t>& aCellIds,
+                                                 const std::vector<double>& aEnergies,
+                                                 std::vector<uint64_t>& aKeptCellIds,
+                                                 std::vector<double>& aKeptEnergies) {
+  // Copy only the cells with energy above a threshold
+  aKeptCellIds.clear();
+  aKeptEnergies.clear();
+  for (size_t iCell = 0; iCell < aCellIds.size(); iCell++) {
+    if (!(aEnergies[iCell] < m_filterThreshold * noiseConstant(aCellIds[iCell], iCell))) {
+      aKeptCellIds.push_back(aCellIds[iCell]);
+      aKeptEnergies.push_back(aEnergies[iCell]);
+    }
+  }
+}
+
+void NoiseCaloCellsFromFileTool::fillNoiseTable(std::vector<uint64_t> aCellIds) {
+  std::sort(aCellIds.begin(), aCellIds.end());
+  aCellIds.erase(std::unique(aCellIds.begin(), aCellIds.end()), aCellIds.end());
+  m_tableCellIds = std::move(aCellIds);
+  m_tableNoise.resize(m_tableCellIds.size());
+  for (size_t iCell = 0; iCell < m_tableCellIds.size(); iCell++) {
+    m_tableNoise[iCell] = getNoiseConstantPerCell(m_tableCellIds[iCell]);
+  }
+  debug() << "Noise constants computed for " << m_tableCellIds.size() << " cells" << endmsg;
+}
+
+double NoiseCaloCellsFromFileTool::noiseConstant(uint64_t aCellId, size_t aIndexHint) {
+  // the cells of all events are usually passed in the order of the table
+  if (aIndexHint < m_tableCellIds.size() && m_tableCellIds[aIndexHint] == aCellId) {
+    return m_tableNoise[aIndexHint];
+  }
+  auto it = std::lower_bound(m_tableCellIds.begin(), m_tableCellIds.end(), aCellId);
+  if (it != m_tableCellIds.end() && *it == aCellId) {
+    return m_tableNoise[it - m_tableCellIds.begin()];
+  }
+  return getNoiseConstantPerCell(aCellId);
+}
+
 StatusCode NoiseCaloCellsFromFileTool::finalize() {
   StatusCode sc = GaudiTool::finalize();
   return sc;
@@ -137,11 +210,8 @@ double NoiseCaloCellsFromFileTool::getNoiseConstantPerCell(int64_t aCellId) {
 
   // Get cell coordinates: eta and radial layer
   double cellEta = m_segmentation->eta(aCellId);
-  // Take readout, bitfield from GeoSvc
-  auto decoder = m_geoSvc->lcdd()->readout(m_readoutName).idSpec().decoder();
-  //decoder->setValue(aCellId);
   dd4hep::DDSegmentation::CellID cID = aCellId;
-  unsigned cellLayer = decoder->get(cID, m_activeFieldName);
+  unsigned cellLayer = m_decoder->get(cID, m_activeFieldName);
 
   // All histograms have same binning, all bins with same size
   // Using the histogram in the first layer to get the bin size
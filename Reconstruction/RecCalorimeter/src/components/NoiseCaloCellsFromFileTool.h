@@ -20,6 +20,9 @@ class TH1F;
  *  Access noise constants from TH1F histogram (noise vs. |eta|)
  *  createRandomCellNoise: Create random CaloHits (gaussian distribution) for the vector of cells
  *  filterCellNoise: remove cells with energy bellow threshold*sigma from the vector of cells
+ *  The noise constants are computed once, for all cells passed in the first call (all cells of the calorimeter,
+ *  as prepared by the geometry tool), and stored in an array parallel to the sorted array of their cellIDs.
+ *  Cells passed in the same order as the table are looked up by their index, others by a binary search.
  *
  *  @author Jana Faltova
  *  @date   2016-09
@@ -40,11 +43,26 @@ public:
   /** @brief Remove cells with energy bellow threshold*sigma from the vector of cells
    */
   virtual void filterCellNoise(std::unordered_map<uint64_t, double>& aCells) final;
+  /** @brief Add random noise to the cells stored in parallel arrays of cellIDs and energies
+   */
+  virtual void addRandomCellNoise(const std::vector<uint64_t>& aCellIds, std::vector<double>& aEnergies) final;
+  /** @brief Copy the cells with energy above threshold*sigma from the parallel arrays of cellIDs and energies
+   *  to the output arrays
+   */
+  virtual void filterCellNoise(const std::vector<uint64_t>& aCellIds, const std::vector<double>& aEnergies,
+                               std::vector<uint64_t>& aKeptCellIds, std::vector<double>& aKeptEnergies) final;
 
   /// Open file and read noise histograms in the memory
   StatusCode initNoiseFromFile();
   /// Find the appropriate noise constant from the histogram
   double getNoiseConstantPerCell(int64_t aCellID);
+  /** Get the noise constant from the table, computed if the cell is not in the table (not added to the table).
+   *  @param[in] aCellId cellID of the cell
+   *  @param[in] aIndexHint expected index of the cell in the table, checked before the binary search
+   */
+  double noiseConstant(uint64_t aCellId, size_t aIndexHint);
+  /// Fill the table of noise constants for the given cells
+  void fillNoiseTable(std::vector<uint64_t> aCellIds);
 
 private:
   /// Add pileup contribution to the electronics noise? (only if read from file)
@@ -82,6 +100,14 @@ private:
   SmartIF<IGeoSvc> m_geoSvc;
   /// PhiEta segmentation
   dd4hep::DDSegmentation::FCCSWGridPhiEta* m_segmentation;
+  /// Decoder of the readout, used to get the layer of the cell
+  dd4hep::DDSegmentation::BitFieldCoder* m_decoder;
+  /// CellIDs of the table of noise constants, sorted
+  std::vector<uint64_t> m_tableCellIds;
+  /// Noise constants (sigma) of the cells in m_tableCellIds
+  std::vector<double> m_tableNoise;
+  /// Buffer of standard normal random numbers, one per cell
+  std::vector<double> m_randomNumbers;
 };
 
 #endif /* RECCALORIMETER_NOISECALOCELLSFROMFILETOOL_H */
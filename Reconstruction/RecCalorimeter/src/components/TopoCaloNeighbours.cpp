@@ -15,34 +15,78 @@ TopoCaloNeighbours::TopoCaloNeighbours(const std::string& type, const std::strin
 StatusCode TopoCaloNeighbours::initialize() {
   StatusCode sc = GaudiTool::initialize();
   if (sc.isFailure()) return sc;
+  if (rec::CaloMapFile::isMapFile(m_fileName)) {
+    std::string errorMessage;
+    if (!m_map.open(m_fileName, errorMessage)) {
+      error() << "Unable to read the neighbours map: " << errorMessage << endmsg;
+      return StatusCode::FAILURE;
+    }
+    if (!m_map.hasNeighbours()) {
+      error() << "File " << m_fileName.value() << " does not contain the neighbours" << endmsg;
+      return StatusCode::FAILURE;
+    }
+  } else {
+    sc = readRootFile();
+    if (sc.isFailure()) return sc;
+  }
+  std::vector<int> counterL;
+  counterL.assign(100,0);
+  for (uint iCell = 0; iCell < m_map.size(); iCell++) {
+    counterL[m_map.neighboursEnd(iCell) - m_map.neighboursBegin(iCell)] ++;
+  }
+  for(uint iCount = 0; iCount < counterL.size(); iCount++) {
+    if (counterL[iCount] != 0) {
+      info() << counterL[iCount] << " cells have " << iCount << " neighbours" << endmsg;
+    }
+  }
+  return sc;
+}
+
+StatusCode TopoCaloNeighbours::readRootFile() {
   TFile file(m_fileName.value().c_str(),"READ");
   TTree* tree = nullptr;
   file.GetObject("neighbours",tree);
+  if (tree == nullptr) {
+    error() << "No TTree \"neighbours\" in file " << m_fileName.value() << endmsg;
+    return StatusCode::FAILURE;
+  }
   ULong64_t readCellId;
   std::vector<uint64_t>* readNeighbours = nullptr;
   tree->SetBranchAddress("cellId",&readCellId);
   tree->SetBranchAddress("neighbours",&readNeighbours);
+  // entries are sorted by cellID to build the CSR arrays
+  std::vector<std::pair<uint64_t, uint>> entries;
+  entries.reserve(tree->GetEntries());
+  TBranch* cellIdBranch = tree->GetBranch("cellId");
   for (uint i = 0; i < tree->GetEntries(); i++) {
-      tree->GetEntry(i);
-      m_map.insert(std::pair<uint64_t, std::vector<uint64_t>>(readCellId, *readNeighbours));
-  }
-  std::vector<int> counterL;
-  counterL.assign(100,0);
-  for(const auto& item: m_map) {
-    counterL[item.second.size()] ++;
+    cellIdBranch->GetEntry(i);
+    entries.emplace_back(readCellId, i);
   }
-  for(uint iCount = 0; iCount < counterL.size(); iCount++) {
-    if (counterL[iCount] != 0) {
-      info() << counterL[iCount] << " cells have " << iCount << " neighbours" << endmsg;
-    }
+  std::sort(entries.begin(), entries.end());
+  std::vector<uint64_t> cellIds, offsets, neighbours;
+  cellIds.reserve(entries.size());
+  offsets.reserve(entries.size() + 1);
+  offsets.push_back(0);
+  for (const auto& entry : entries) {
+    // the first entry of a duplicated cellID is kept, as for the insertion in a map
+    if (!cellIds.empty() && cellIds.back() == entry.first) continue;
+    tree->GetEntry(entry.second);
+    cellIds.push_back(readCellId);
+    neighbours.insert(neighbours.end(), readNeighbours->begin(), readNeighbours->end());
+    offsets.push_back(neighbours.size());
   }
+  m_map.assign(std::move(cellIds), std::move(offsets), std::move(neighbours), {}, {});
   delete tree;
   delete readNeighbours;
-  return sc;
+  return StatusCode::SUCCESS;
 }
 
 StatusCode TopoCaloNeighbours::finalize() { return GaudiTool::finalize(); }
 
-std::vector<uint64_t>& TopoCaloNeighbours::neighbours(uint64_t aCellId) {
-  return m_map[aCellId];
+ICaloReadNeighboursMap::Neighbours TopoCaloNeighbours::neighbours(uint64_t aCellId) const {
+  size_t index = m_map.index(aCellId);
+  if (index == m_map.size()) {
+    return {};
+  }
+  return {m_map.neighboursBegin(index), m_map.neighboursEnd(index)};
 }
@@ -5,6 +5,7 @@
 #include "GaudiAlg/GaudiTool.h"
 
 // FCCSW
+#include "RecCalorimeter/CaloMapFile.h"
 #include "RecInterface/ICaloReadNeighboursMap.h"
 
 class IGeoSvc;
@@ -12,8 +13,10 @@ class IGeoSvc;
 /** @class TopoCaloNeighbours Reconstruction/RecCalorimeter/src/components/TopoCaloNeighbours.h
  *TopoCaloNeighbours.h
  *
- *  Tool that reads a ROOT file containing the TTree with branch "cellId" and branch "neighbours".
- *  This tools reads the tree, creates a map, and allows a lookup of all neighbours of a cell.
+ *  Tool that reads a ROOT file containing the TTree with branch "cellId" and branch "neighbours",
+ *  or maps read-only a binary map file (see rec::CaloMapFile) written by CreateFCChhCaloNeighbours.
+ *  The file type is recognised from its content.
+ *  This tools allows a lookup of all neighbours of a cell (binary search in the sorted cellIDs).
  *
  *  @author Anna Zaborowska
  *  @author Coralie Neubueser
@@ -31,15 +34,17 @@ public:
   
   /** Function to be called for the neighbours of a cell.
    *   @param[in] aCellId, cellid of the cell of interest.
-   *   @return vector of cellIDs, corresponding to the cells neighbours.
+   *   @return view of the cellIDs of the cells neighbours (empty if the cell is not in the map), no copy is made.
    */
-  virtual std::vector<uint64_t>& neighbours(uint64_t aCellId) final;
+  virtual Neighbours neighbours(uint64_t aCellId) const final;
 
 private:
-  /// Name of input root file that contains the TTree with cellID->vec<neighboursCellID>
+  /// Read the ROOT file with the TTree of cellID->vec<neighboursCellID> into the map
+  StatusCode readRootFile();
+  /// Name of input root file that contains the TTree with cellID->vec<neighboursCellID>, or of the binary map file
   Gaudi::Property<std::string> m_fileName{this, "fileName", "neighbours_map.root"};
-  /// Output map to be used for the fast lookup in the topo-clusering algorithm
-  std::unordered_map<uint64_t, std::vector<uint64_t>> m_map;
+  /// Map to be used for the fast lookup in the topo-clusering algorithm
+  rec::CaloMapFile m_map;
 };
 
 #endif /* RECCALORIMETER_TOPOCALONEIGHBOURS_H */
@@ -4,6 +4,8 @@
 #include "TFile.h"
 #include "TTree.h"
 
+#include <tuple>
+
 DECLARE_TOOL_FACTORY(TopoCaloNoisyCells)
 
 TopoCaloNoisyCells::TopoCaloNoisyCells(const std::string& type, const std::string& name, const IInterface* parent)
@@ -14,24 +16,67 @@ TopoCaloNoisyCells::TopoCaloNoisyCells(const std::string& type, const std::strin
 StatusCode TopoCaloNoisyCells::initialize() {
   StatusCode sc = GaudiTool::initialize();
   if (sc.isFailure()) return sc;
+  if (!rec::CaloMapFile::isMapFile(m_fileName)) return readRootFile();
+  std::string errorMessage;
+  if (!m_map.open(m_fileName, errorMessage)) {
+    error() << "Unable to read the noise map: " << errorMessage << endmsg;
+    return StatusCode::FAILURE;
+  }
+  if (!m_map.hasNoise()) {
+    error() << "File " << m_fileName.value() << " does not contain the noise levels" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  return sc;
+}
+
+StatusCode TopoCaloNoisyCells::readRootFile() {
   TFile file(m_fileName.value().c_str(), "READ");
   TTree* tree = nullptr;
   file.GetObject("noisyCells", tree);
+  if (tree == nullptr) {
+    error() << "No TTree \"noisyCells\" in file " << m_fileName.value() << endmsg;
+    return StatusCode::FAILURE;
+  }
   ULong64_t readCellId;
   double readNoisyCells;
   double readNoisyCellsOffset;
   tree->SetBranchAddress("cellId", &readCellId);
   tree->SetBranchAddress("noiseLevel", &readNoisyCells);
   tree->SetBranchAddress("noiseOffset", &readNoisyCellsOffset);
+  std::vector<std::tuple<uint64_t, double, double>> entries;
+  entries.reserve(tree->GetEntries());
   for (uint i = 0; i < tree->GetEntries(); i++) {
     tree->GetEntry(i);
-    m_map.insert(std::pair<uint64_t, std::pair<double, double>>(readCellId, std::make_pair(readNoisyCells, readNoisyCellsOffset)));
+    entries.emplace_back(readCellId, readNoisyCells, readNoisyCellsOffset);
+  }
+  // the first entry of a duplicated cellID is kept, as for the insertion in a map
+  std::stable_sort(entries.begin(), entries.end(), [](const std::tuple<uint64_t, double, double>& a,
+                                                      const std::tuple<uint64_t, double, double>& b) {
+    return std::get<0>(a) < std::get<0>(b);
+  });
+  std::vector<uint64_t> cellIds;
+  std::vector<double> noiseLevel, noiseOffset;
+  cellIds.reserve(entries.size());
+  noiseLevel.reserve(entries.size());
+  noiseOffset.reserve(entries.size());
+  for (const auto& entry : entries) {
+    if (!cellIds.empty() && cellIds.back() == std::get<0>(entry)) continue;
+    cellIds.push_back(std::get<0>(entry));
+    noiseLevel.push_back(std::get<1>(entry));
+    noiseOffset.push_back(std::get<2>(entry));
   }
+  m_map.assign(std::move(cellIds), {}, {}, std::move(noiseLevel), std::move(noiseOffset));
   delete tree;
-  return sc;
+  return StatusCode::SUCCESS;
 }
 
 StatusCode TopoCaloNoisyCells::finalize() { return GaudiTool::finalize(); }
 
-double TopoCaloNoisyCells::noiseRMS(uint64_t aCellId) { return m_map[aCellId].first; }
-double TopoCaloNoisyCells::noiseOffset(uint64_t aCellId) { return m_map[aCellId].second; }
+double TopoCaloNoisyCells::noiseRMS(uint64_t aCellId) {
+  size_t index = m_map.index(aCellId);
+  return index == m_map.size() ? 0 : m_map.noiseLevel(index);
+}
+double TopoCaloNoisyCells::noiseOffset(uint64_t aCellId) {
+  size_t index = m_map.index(aCellId);
+  return index == m_map.size() ? 0 : m_map.noiseOffset(index);
+}
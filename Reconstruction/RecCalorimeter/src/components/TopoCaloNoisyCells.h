@@ -5,6 +5,7 @@
 #include "GaudiAlg/GaudiTool.h"
 
 // FCCSW
+#include "RecCalorimeter/CaloMapFile.h"
 #include "RecInterface/ICaloReadCellNoiseMap.h"
 
 class IGeoSvc;
@@ -13,7 +14,9 @@ class IGeoSvc;
  *TopoCaloNoisyCells.h
  *
  *  Tool that reads a ROOT file containing the TTree with branchs "cellId", "noiseLevel", and "noiseOffset".
- *  This tool reads the tree, creates a map, and allows a lookup of noise level and mean noise of a cell, by its cellID.
+ *  Alternatively the binary map file (see rec::CaloMapFile) written by CreateFCChhCaloNoiseLevelMap is mapped read-only,
+ *  the file type is recognised from its content.
+ *  This tool allows a lookup of noise level and mean noise of a cell, by its cellID (zero if the cell is not in the map).
  *
  *  @author Coralie Neubueser
  */
@@ -41,10 +44,13 @@ public:
   virtual double noiseOffset(uint64_t aCellId) final;
 
 private:
-  /// Name
+  /// Read the ROOT file with the TTree of cellID->noise values into the map
+  StatusCode readRootFile();
+  /// Name of input root file or of the binary map file
   Gaudi::Property<std::string> m_fileName{this, "fileName",
                                           "/afs/cern.ch/user/c/cneubuse/public/FCChh/cellNoise_map_segHcal.root"};
-  std::unordered_map<uint64_t, std::pair<double,double>> m_map;
+  /// Map of cellID to noise level and offset
+  rec::CaloMapFile m_map;
 };
 
 #endif /* RECCALORIMETER_TOPOCALONOISYCELLS_H */
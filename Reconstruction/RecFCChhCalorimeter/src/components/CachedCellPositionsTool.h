@@ -0,0 +1,46 @@
+#ifndef RECCALORIMETER_CACHEDCELLPOSITIONSTOOL_H
+#define RECCALORIMETER_CACHEDCELLPOSITIONSTOOL_H
+
+// GAUDI
+#include "GaudiAlg/GaudiTool.h"
+
+// FCCSW
+#include "RecCalorimeter/CellPositionsCache.h"
+#include "RecInterface/ICellPositionsTool.h"
+
+/** @class CachedCellPositionsTool Reconstruction/RecFCChhCalorimeter/src/components/CachedCellPositionsTool.h
+ *   CachedCellPositionsTool.h
+ *
+ *  Base of the cell positions tools: xyzPosition() returns the position computed by the derived tool
+ *  (computePosition()) on the first request of a cell, and the cached one afterwards.
+ *  The cache can be switched off with the property cachePositions.
+ */
+
+class CachedCellPositionsTool : public GaudiTool, virtual public ICellPositionsTool {
+public:
+  CachedCellPositionsTool(const std::string& type, const std::string& name, const IInterface* parent)
+      : GaudiTool(type, name, parent) {
+    declareInterface<ICellPositionsTool>(this);
+  }
+  virtual ~CachedCellPositionsTool() = default;
+
+  /** Global position of the cell, computed from the geometry on the first call and cached for the following ones.
+   *   @param[in] aCellId cellID of the cell
+   *   @return position of the cell
+   */
+  virtual dd4hep::Position xyzPosition(const uint64_t& aCellId) const final {
+    if (!m_cachePositions) return computePosition(aCellId);
+    return m_positionsCache.position(aCellId, [this](uint64_t aId) { return computePosition(aId); });
+  }
+
+protected:
+  /// Compute the position of the cell from the geometry
+  virtual dd4hep::Position computePosition(uint64_t aCellId) const = 0;
+
+private:
+  /// Flag whether the cell positions are cached (computed once per cell)
+  Gaudi::Property<bool> m_cachePositions{this, "cachePositions", true, "Cache the position of each cell"};
+  /// Positions of the cells already requested
+  mutable rec::CellPositionsCache m_positionsCache;
+};
+#endif /* RECCALORIMETER_CACHEDCELLPOSITIONSTOOL_H */
@@ -7,9 +7,7 @@ DECLARE_TOOL_FACTORY(CellPositionsCaloDiscsTool)
 
 CellPositionsCaloDiscsTool::CellPositionsCaloDiscsTool(const std::string& type, const std::string& name,
                                                        const IInterface* parent)
-    : GaudiTool(type, name, parent) {
-  declareInterface<ICellPositionsTool>(this);
-}
+    : CachedCellPositionsTool(type, name, parent) {}
 
 StatusCode CellPositionsCaloDiscsTool::initialize() {
   StatusCode sc = GaudiTool::initialize();
@@ -61,7 +59,7 @@ void CellPositionsCaloDiscsTool::getPositions(const fcc::CaloHitCollection& aCel
   debug() << "Output positions collection size: " << outputColl.size() << endmsg;
 }
 
-dd4hep::Position CellPositionsCaloDiscsTool::xyzPosition(const uint64_t& aCellId) const {
+dd4hep::Position CellPositionsCaloDiscsTool::computePosition(uint64_t aCellId) const {
   double radius;
   dd4hep::DDSegmentation::CellID volumeId = aCellId;
   m_decoder->set(volumeId, "phi", 0);
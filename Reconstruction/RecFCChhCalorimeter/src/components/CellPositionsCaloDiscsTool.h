@@ -2,15 +2,14 @@
 #define RECCALORIMETER_CELLPOSITIONSCALODISCSTOOL_H
 
 // GAUDI
-#include "GaudiAlg/GaudiTool.h"
 #include "GaudiKernel/ServiceHandle.h"
 
 // FCCSW
+#include "CachedCellPositionsTool.h"
 #include "DetCommon/DetUtils.h"
 #include "DetInterface/IGeoSvc.h"
 #include "DetSegmentation/FCCSWGridPhiEta.h"
 #include "FWCore/DataHandle.h"
-#include "RecInterface/ICellPositionsTool.h"
 
 // DD4hep
 #include "DD4hep/Readout.h"
@@ -35,7 +34,7 @@ class Segmentation;
  *  @author Coralie Neubueser
 */
 
-class CellPositionsCaloDiscsTool : public GaudiTool, virtual public ICellPositionsTool {
+class CellPositionsCaloDiscsTool : public CachedCellPositionsTool {
 
 public:
   CellPositionsCaloDiscsTool(const std::string& type, const std::string& name, const IInterface* parent);
@@ -47,8 +46,6 @@ public:
 
   virtual void getPositions(const fcc::CaloHitCollection& aCells, fcc::PositionedCaloHitCollection& outputColl) final;
 
-  virtual dd4hep::Position xyzPosition(const uint64_t& aCellId) const final;
-
   virtual int layerId(const uint64_t& aCellId) final;
 
 private:
@@ -62,5 +59,7 @@ private:
   dd4hep::DDSegmentation::BitFieldCoder* m_decoder;
   /// Volume manager
   dd4hep::VolumeManager m_volman;
+  /// Position of the cell: eta-phi direction of the segmentation, at the z of the disc volume
+  virtual dd4hep::Position computePosition(uint64_t aCellId) const final;
 };
 #endif /* RECCALORIMETER_CELLPOSITIONSCALODISCSTOOL_H */
@@ -8,9 +8,7 @@ DECLARE_TOOL_FACTORY(CellPositionsECalBarrelTool)
 
 CellPositionsECalBarrelTool::CellPositionsECalBarrelTool(const std::string& type, const std::string& name,
                                                          const IInterface* parent)
-    : GaudiTool(type, name, parent) {
-  declareInterface<ICellPositionsTool>(this);
-}
+    : CachedCellPositionsTool(type, name, parent) {}
 
 StatusCode CellPositionsECalBarrelTool::initialize() {
   StatusCode sc = GaudiTool::initialize();
@@ -65,7 +63,7 @@ void CellPositionsECalBarrelTool::getPositions(const fcc::CaloHitCollection& aCe
   debug() << "Output positions collection size: " << outputColl.size() << endmsg;
 }
 
-dd4hep::Position CellPositionsECalBarrelTool::xyzPosition(const uint64_t& aCellId) const {
+dd4hep::Position CellPositionsECalBarrelTool::computePosition(uint64_t aCellId) const {
   double radius;
   dd4hep::DDSegmentation::CellID volumeId = aCellId;
   m_decoder->set(volumeId, "phi", 0);
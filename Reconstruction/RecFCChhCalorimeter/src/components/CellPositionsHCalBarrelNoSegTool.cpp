@@ -7,9 +7,7 @@ DECLARE_TOOL_FACTORY(CellPositionsHCalBarrelNoSegTool)
 
 CellPositionsHCalBarrelNoSegTool::CellPositionsHCalBarrelNoSegTool(const std::string& type, const std::string& name,
                                                                    const IInterface* parent)
-    : GaudiTool(type, name, parent) {
-  declareInterface<ICellPositionsTool>(this);
-}
+    : CachedCellPositionsTool(type, name, parent) {}
 
 StatusCode CellPositionsHCalBarrelNoSegTool::initialize() {
   StatusCode sc = GaudiTool::initialize();
@@ -56,7 +54,7 @@ void CellPositionsHCalBarrelNoSegTool::getPositions(const fcc::CaloHitCollection
   debug() << "Output positions collection size: " << outputColl.size() << endmsg;
 }
 
-dd4hep::Position CellPositionsHCalBarrelNoSegTool::xyzPosition(const uint64_t& aCellId) const {
+dd4hep::Position CellPositionsHCalBarrelNoSegTool::computePosition(uint64_t aCellId) const {
   // global cartesian coordinates calculated from r,phi,eta, for r=1
   auto detelement = m_volman.lookupDetElement(aCellId);
   const auto& transform = detelement.nominal().worldTransformation();
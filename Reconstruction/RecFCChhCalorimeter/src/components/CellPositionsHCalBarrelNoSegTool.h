@@ -2,14 +2,13 @@
 #define RECCALORIMETER_CELLPOSITIONSHCALBARRELNOSEGTOOL_H
 
 // GAUDI
-#include "GaudiAlg/GaudiTool.h"
 #include "GaudiKernel/ServiceHandle.h"
 
 // FCCSW
+#include "CachedCellPositionsTool.h"
 #include "DetCommon/DetUtils.h"
 #include "DetInterface/IGeoSvc.h"
 #include "FWCore/DataHandle.h"
-#include "RecInterface/ICellPositionsTool.h"
 
 // DD4hep
 #include "DD4hep/Readout.h"
@@ -34,7 +33,7 @@ class Segmentation;
  *  @author Coralie Neubueser
  */
 
-class CellPositionsHCalBarrelNoSegTool : public GaudiTool, virtual public ICellPositionsTool {
+class CellPositionsHCalBarrelNoSegTool : public CachedCellPositionsTool {
 public:
   CellPositionsHCalBarrelNoSegTool(const std::string& type, const std::string& name, const IInterface* parent);
   ~CellPositionsHCalBarrelNoSegTool() = default;
@@ -45,8 +44,6 @@ public:
 
   virtual void getPositions(const fcc::CaloHitCollection& aCells, fcc::PositionedCaloHitCollection& outputColl) final;
 
-  virtual dd4hep::Position xyzPosition(const uint64_t& aCellId) const final;
-
   virtual int layerId(const uint64_t& aCellId) final;
 
 private:
@@ -58,5 +55,7 @@ private:
   dd4hep::DDSegmentation::BitFieldCoder* m_decoder;
   /// Volume manager
   dd4hep::VolumeManager m_volman;
+  /// Position of the cell: centre of the cell volume (readout without segmentation)
+  virtual dd4hep::Position computePosition(uint64_t aCellId) const final;
 };
 #endif /* RECCALORIMETER_CELLPOSITIONSHCALBARRELNOSEGTOOL_H */
@@ -8,9 +8,7 @@ DECLARE_TOOL_FACTORY(CellPositionsTailCatcherTool)
 CellPositionsTailCatcherTool::CellPositionsTailCatcherTool(const std::string& type,
                                                            const std::string& name,
                                                            const IInterface* parent)
-    : GaudiTool(type, name, parent) {
-  declareInterface<ICellPositionsTool>(this);
-}
+    : CachedCellPositionsTool(type, name, parent) {}
 
 StatusCode CellPositionsTailCatcherTool::initialize() {
   StatusCode sc = GaudiTool::initialize();
@@ -65,7 +63,7 @@ void CellPositionsTailCatcherTool::getPositions(const fcc::CaloHitCollection& aC
   debug() << "Output positions collection size: " << outputColl.size() << endmsg;
 }
 
-dd4hep::Position CellPositionsTailCatcherTool::xyzPosition(const uint64_t& aCellId) const {
+dd4hep::Position CellPositionsTailCatcherTool::computePosition(uint64_t aCellId) const {
   double radius;
 
   auto detelement = m_volman.lookupDetElement(aCellId);
@@ -2,15 +2,14 @@
 #define RECCALORIMETER_CELLPOSITIONSTAILCATCHERTOOL_H
 
 // GAUDI
-#include "GaudiAlg/GaudiTool.h"
 #include "GaudiKernel/ServiceHandle.h"
 
 // FCCSW
+#include "CachedCellPositionsTool.h"
 #include "DetCommon/DetUtils.h"
 #include "DetInterface/IGeoSvc.h"
 #include "DetSegmentation/FCCSWGridPhiEta.h"
 #include "FWCore/DataHandle.h"
-#include "RecInterface/ICellPositionsTool.h"
 
 // DD4hep
 #include "DD4hep/Readout.h"
@@ -35,7 +34,7 @@ class Segmentation;
  *  @author Coralie Neubueser
 */
 
-class CellPositionsTailCatcherTool : public GaudiTool, virtual public ICellPositionsTool {
+class CellPositionsTailCatcherTool : public CachedCellPositionsTool {
 public:
   CellPositionsTailCatcherTool(const std::string& type, const std::string& name, const IInterface* parent);
   ~CellPositionsTailCatcherTool() = default;
@@ -46,8 +45,6 @@ public:
 
   virtual void getPositions(const fcc::CaloHitCollection& aCells, fcc::PositionedCaloHitCollection& outputColl) final;
 
-  virtual dd4hep::Position xyzPosition(const uint64_t& aCellId) const final;
-
   virtual int layerId(const uint64_t& aCellId) final;
 
 private:
@@ -63,5 +60,7 @@ private:
   dd4hep::DDSegmentation::BitFieldCoder* m_decoder;
   /// Volume manager
   dd4hep::VolumeManager m_volman;
+  /// Position of the cell: eta-phi direction of the segmentation, at the z of the endcap volume or at centralRadius
+  virtual dd4hep::Position computePosition(uint64_t aCellId) const final;
 };
 #endif /* RECCALORIMETER_CELLPOSITIONSTAILCATCHERTOOL_H */
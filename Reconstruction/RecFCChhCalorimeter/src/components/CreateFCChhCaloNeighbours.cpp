@@ -3,6 +3,7 @@
 #include "DD4hep/Detector.h"
 #include "DetCommon/DetUtils.h"
 #include "DetInterface/IGeoSvc.h"
+#include "RecCalorimeter/CaloMapFile.h"
 
 #include "TFile.h"
 #include "TTree.h"
@@ -12,6 +13,7 @@ DECLARE_SERVICE_FACTORY(CreateFCChhCaloNeighbours)
 CreateFCChhCaloNeighbours::CreateFCChhCaloNeighbours(const std::string& aName, ISvcLocator* aSL)
     : base_class(aName, aSL) {
   declareProperty( "outputFileName", m_outputFileName, "Name of the output file");
+  declareProperty( "outputBinaryFileName", m_outputBinaryFileName, "Name of the output binary map file (optional)");
 }
 
 CreateFCChhCaloNeighbours::~CreateFCChhCaloNeighbours() {}
@@ -373,6 +375,27 @@ StatusCode CreateFCChhCaloNeighbours::initialize() {
   file.Write();
   file.Close();
 
+  if (!m_outputBinaryFileName.empty()) {
+    std::vector<uint64_t> cellIds;
+    cellIds.reserve(map.size());
+    for (const auto& item : map) {
+      cellIds.push_back(item.first);
+    }
+    std::sort(cellIds.begin(), cellIds.end());
+    std::vector<uint64_t> offsets(1, 0);
+    offsets.reserve(cellIds.size() + 1);
+    std::vector<uint64_t> neighbours;
+    for (auto cellId : cellIds) {
+      const auto& cellNeighbours = map.find(cellId)->second;
+      neighbours.insert(neighbours.end(), cellNeighbours.begin(), cellNeighbours.end());
+      offsets.push_back(neighbours.size());
+    }
+    if (!rec::CaloMapFile::write(m_outputBinaryFileName, cellIds, offsets, neighbours, {}, {})) {
+      error() << "Unable to write the binary map file " << m_outputBinaryFileName << endmsg;
+      return StatusCode::FAILURE;
+    }
+  }
+
   return StatusCode::SUCCESS;
 }
 
@@ -61,6 +61,8 @@ private:
       {"layerVolume", "moduleVolume", "wedgeVolume"}};  // to find out number of volumes
   /// Name of output file
   std::string m_outputFileName;
+  /// Name of the output binary map file (see rec::CaloMapFile), not written if empty
+  std::string m_outputBinaryFileName;
 
   // For combination of barrels: flag if ECal and HCal barrels should be merged
   Gaudi::Property<bool> m_connectBarrels{this, "connectBarrels", true};
@@ -3,6 +3,7 @@
 #include "DD4hep/Detector.h"
 #include "DetCommon/DetUtils.h"
 #include "DetInterface/IGeoSvc.h"
+#include "RecCalorimeter/CaloMapFile.h"
 
 #include "TFile.h"
 #include "TTree.h"
@@ -14,6 +15,7 @@ CreateFCChhCaloNoiseLevelMap::CreateFCChhCaloNoiseLevelMap(const std::string& aN
   declareProperty("ECalBarrelNoiseTool", m_ecalBarrelNoiseTool, "Handle for the cells noise tool of Barrel ECal");
   declareProperty("HCalBarrelNoiseTool", m_hcalBarrelNoiseTool, "Handle for the cells noise tool of Barrel HCal");
   declareProperty( "outputFileName", m_outputFileName, "Name of the output file");
+  declareProperty( "outputBinaryFileName", m_outputBinaryFileName, "Name of the output binary map file (optional)");
 }
 
 CreateFCChhCaloNoiseLevelMap::~CreateFCChhCaloNoiseLevelMap() {}
@@ -207,6 +209,27 @@ StatusCode CreateFCChhCaloNoiseLevelMap::initialize() {
   file.Write();
   file.Close();
 
+  if (!m_outputBinaryFileName.empty()) {
+    std::vector<uint64_t> cellIds;
+    cellIds.reserve(map.size());
+    for (const auto& item : map) {
+      cellIds.push_back(item.first);
+    }
+    std::sort(cellIds.begin(), cellIds.end());
+    std::vector<double> noiseLevel, noiseOffset;
+    noiseLevel.reserve(cellIds.size());
+    noiseOffset.reserve(cellIds.size());
+    for (auto cellId : cellIds) {
+      const auto& noise = map.find(cellId)->second;
+      noiseLevel.push_back(noise.first);
+      noiseOffset.push_back(noise.second);
+    }
+    if (!rec::CaloMapFile::write(m_outputBinaryFileName, cellIds, {}, {}, noiseLevel, noiseOffset)) {
+      error() << "Unable to write the binary map file " << m_outputBinaryFileName << endmsg;
+      return StatusCode::FAILURE;
+    }
+  }
+
   return StatusCode::SUCCESS;
 }
 
@@ -71,6 +71,8 @@ private:
 
   /// Name of output file
   std::string m_outputFileName;
+  /// Name of the output binary map file (see rec::CaloMapFile), not written if empty
+  std::string m_outputBinaryFileName;
 };
 
 #endif /* RECALORIMETER_CREATEFCCHHCALONOISELEVELMAP_H */
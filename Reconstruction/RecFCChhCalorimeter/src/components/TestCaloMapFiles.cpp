@@ -0,0 +1,126 @@
+#include "TestCaloMapFiles.h"
+
+// FCCSW
+#include "RecCalorimeter/CaloMapFile.h"
+
+// ROOT
+#include "TFile.h"
+#include "TTree.h"
+
+#include <algorithm>
+
+DECLARE_ALGORITHM_FACTORY(TestCaloMapFiles)
+
+TestCaloMapFiles::TestCaloMapFiles(const std::string& name, ISvcLocator* svcLoc) : GaudiAlgorithm(name, svcLoc) {
+  declareProperty("neighboursRootTool", m_neighboursRoot, "Handle for the neighbours read from the ROOT file");
+  declareProperty("neighboursBinaryTool", m_neighboursBinary, "Handle for the neighbours read from the binary file");
+  declareProperty("noiseRootTool", m_noiseRoot, "Handle for the noise read from the ROOT file");
+  declareProperty("noiseBinaryTool", m_noiseBinary, "Handle for the noise read from the binary file");
+}
+
+StatusCode TestCaloMapFiles::initialize() {
+  StatusCode sc = GaudiAlgorithm::initialize();
+  if (sc.isFailure()) return sc;
+  if (!m_neighboursRoot.retrieve() || !m_neighboursBinary.retrieve()) {
+    error() << "Unable to retrieve the neighbours tools" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  if (!m_noiseRoot.retrieve() || !m_noiseBinary.retrieve()) {
+    error() << "Unable to retrieve the noise tools" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  return sc;
+}
+
+StatusCode TestCaloMapFiles::execute() {
+  std::vector<uint64_t> neighbourCells, noiseCells;
+  if (readCellIds(m_neighboursRootFile, "neighbours", neighbourCells).isFailure() ||
+      readCellIds(m_noiseRootFile, "noisyCells", noiseCells).isFailure()) {
+    return StatusCode::FAILURE;
+  }
+
+  for (auto cellId : neighbourCells) {
+    auto fromRoot = m_neighboursRoot->neighbours(cellId);
+    auto fromBinary = m_neighboursBinary->neighbours(cellId);
+    if (!std::equal(fromRoot.begin(), fromRoot.end(), fromBinary.begin(), fromBinary.end())) {
+      error() << "Neighbours of cell " << cellId << " differ: " << fromRoot.size() << " in ROOT file, "
+              << fromBinary.size() << " in binary file" << endmsg;
+      return StatusCode::FAILURE;
+    }
+  }
+  for (auto cellId : noiseCells) {
+    if (m_noiseRoot->noiseRMS(cellId) != m_noiseBinary->noiseRMS(cellId) ||
+        m_noiseRoot->noiseOffset(cellId) != m_noiseBinary->noiseOffset(cellId)) {
+      error() << "Noise of cell " << cellId << " differs: " << m_noiseRoot->noiseRMS(cellId) << " / "
+              << m_noiseRoot->noiseOffset(cellId) << " in ROOT file, " << m_noiseBinary->noiseRMS(cellId) << " / "
+              << m_noiseBinary->noiseOffset(cellId) << " in binary file" << endmsg;
+      return StatusCode::FAILURE;
+    }
+  }
+  info() << "Neighbours of " << neighbourCells.size() << " cells and noise of " << noiseCells.size()
+         << " cells are the same in the ROOT and binary files" << endmsg;
+
+  // a cell that is in none of the maps, looked up twice: it must neither be found nor be added
+  uint64_t missingCell = std::max(neighbourCells.back(), noiseCells.back()) + 1;
+  for (int iLookup = 0; iLookup < 2; ++iLookup) {
+    if (!m_neighboursRoot->neighbours(missingCell).empty() || !m_neighboursBinary->neighbours(missingCell).empty() ||
+        m_noiseRoot->noiseRMS(missingCell) != 0 || m_noiseBinary->noiseRMS(missingCell) != 0 ||
+        m_noiseRoot->noiseOffset(missingCell) != 0 || m_noiseBinary->noiseOffset(missingCell) != 0) {
+      error() << "Cell " << missingCell << " missing from the maps has neighbours or noise" << endmsg;
+      return StatusCode::FAILURE;
+    }
+  }
+  if (checkMissingCell(m_neighboursBinaryFile, neighbourCells.size(), missingCell).isFailure() ||
+      checkMissingCell(m_noiseBinaryFile, noiseCells.size(), missingCell).isFailure()) {
+    return StatusCode::FAILURE;
+  }
+  return StatusCode::SUCCESS;
+}
+
+StatusCode TestCaloMapFiles::readCellIds(const std::string& aFileName, const std::string& aTreeName,
+                                         std::vector<uint64_t>& aCellIds) {
+  TFile file(aFileName.c_str(), "READ");
+  TTree* tree = nullptr;
+  file.GetObject(aTreeName.c_str(), tree);
+  if (tree == nullptr) {
+    error() << "No TTree \"" << aTreeName << "\" in file " << aFileName << endmsg;
+    return StatusCode::FAILURE;
+  }
+  ULong64_t readCellId;
+  tree->SetBranchStatus("*", 0);
+  tree->SetBranchStatus("cellId", 1);
+  tree->SetBranchAddress("cellId", &readCellId);
+  for (uint i = 0; i < tree->GetEntries(); i++) {
+    tree->GetEntry(i);
+    aCellIds.push_back(readCellId);
+  }
+  delete tree;
+  // the maps keep the first entry of a duplicated cellID
+  std::sort(aCellIds.begin(), aCellIds.end());
+  aCellIds.erase(std::unique(aCellIds.begin(), aCellIds.end()), aCellIds.end());
+  if (aCellIds.empty()) {
+    error() << "No cells in file " << aFileName << endmsg;
+    return StatusCode::FAILURE;
+  }
+  return StatusCode::SUCCESS;
+}
+
+StatusCode TestCaloMapFiles::checkMissingCell(const std::string& aFileName, size_t aNumCells, uint64_t aCellId) {
+  rec::CaloMapFile map;
+  std::string errorMessage;
+  if (!map.open(aFileName, errorMessage)) {
+    error() << "Unable to read the map: " << errorMessage << endmsg;
+    return StatusCode::FAILURE;
+  }
+  if (map.size() != aNumCells) {
+    error() << "File " << aFileName << " has " << map.size() << " cells instead of " << aNumCells << endmsg;
+    return StatusCode::FAILURE;
+  }
+  if (map.index(aCellId) != map.size() || map.size() != aNumCells) {
+    error() << "Lookup of the missing cell " << aCellId << " changed the map of file " << aFileName << endmsg;
+    return StatusCode::FAILURE;
+  }
+  return StatusCode::SUCCESS;
+}
+
+StatusCode TestCaloMapFiles::finalize() { return GaudiAlgorithm::finalize(); }
@@ -0,0 +1,60 @@
+#ifndef RECFCCHHCALORIMETER_TESTCALOMAPFILES_H
+#define RECFCCHHCALORIMETER_TESTCALOMAPFILES_H
+
+// Gaudi
+#include "GaudiAlg/GaudiAlgorithm.h"
+#include "GaudiKernel/ToolHandle.h"
+
+// FCCSW
+#include "RecInterface/ICaloReadCellNoiseMap.h"
+#include "RecInterface/ICaloReadNeighboursMap.h"
+
+/** @class TestCaloMapFiles Reconstruction/RecFCChhCalorimeter/src/components/TestCaloMapFiles.h TestCaloMapFiles.h
+ *
+ *  Test of the binary maps written by CreateFCChhCaloNeighbours and CreateFCChhCaloNoiseLevelMap
+ *  (outputBinaryFileName), read back through the tools TopoCaloNeighbours and TopoCaloNoisyCells.
+ *  For all cells of the ROOT files the neighbours and noise values of the binary maps have to be the same as the ones
+ *  of the ROOT files. A cell missing from the maps has no neighbours and no noise, and is not added to the maps.
+ *
+ */
+
+class TestCaloMapFiles : public GaudiAlgorithm {
+public:
+  TestCaloMapFiles(const std::string& name, ISvcLocator* svcLoc);
+  /**  Initialize.
+   *   @return status code
+   */
+  StatusCode initialize();
+  /**  Execute: compare the maps.
+   *   @return status code
+   */
+  StatusCode execute();
+  /**  Finalize.
+   *   @return status code
+   */
+  StatusCode finalize();
+
+private:
+  /// Read the cellIDs stored in a tree of a ROOT map file
+  StatusCode readCellIds(const std::string& aFileName, const std::string& aTreeName, std::vector<uint64_t>& aCellIds);
+  /// Check that a map file has the expected number of cells and does not contain the cell
+  StatusCode checkMissingCell(const std::string& aFileName, size_t aNumCells, uint64_t aCellId);
+  /// Neighbours read from the ROOT file
+  ToolHandle<ICaloReadNeighboursMap> m_neighboursRoot{"TopoCaloNeighbours/NeighboursRoot", this};
+  /// Neighbours read from the binary file
+  ToolHandle<ICaloReadNeighboursMap> m_neighboursBinary{"TopoCaloNeighbours/NeighboursBinary", this};
+  /// Noise read from the ROOT file
+  ToolHandle<ICaloReadCellNoiseMap> m_noiseRoot{"TopoCaloNoisyCells/NoiseRoot", this};
+  /// Noise read from the binary file
+  ToolHandle<ICaloReadCellNoiseMap> m_noiseBinary{"TopoCaloNoisyCells/NoiseBinary", this};
+  /// Name of the ROOT file with the neighbours, listing the cells to compare
+  Gaudi::Property<std::string> m_neighboursRootFile{this, "neighboursRootFile", "cellNeighbours_Barrel.root"};
+  /// Name of the binary file with the neighbours
+  Gaudi::Property<std::string> m_neighboursBinaryFile{this, "neighboursBinaryFile", "cellNeighbours_Barrel.bin"};
+  /// Name of the ROOT file with the noise, listing the cells to compare
+  Gaudi::Property<std::string> m_noiseRootFile{this, "noiseRootFile", "cellNoise_Barrel.root"};
+  /// Name of the binary file with the noise
+  Gaudi::Property<std::string> m_noiseBinaryFile{this, "noiseBinaryFile", "cellNoise_Barrel.bin"};
+};
+
+#endif /* RECFCCHHCALORIMETER_TESTCALOMAPFILES_H */
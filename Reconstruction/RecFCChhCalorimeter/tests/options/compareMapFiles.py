@@ -0,0 +1,29 @@
+from Gaudi.Configuration import *
+
+# compares the binary maps to the ROOT maps, both written by the tests buildingCellNeighboursMap and buildingCellNoiseMap
+from Configurables import TopoCaloNeighbours, TopoCaloNoisyCells
+neighboursRoot = TopoCaloNeighbours("NeighboursRoot", fileName="cellNeighbours_Barrel.root", OutputLevel=INFO)
+neighboursBinary = TopoCaloNeighbours("NeighboursBinary", fileName="cellNeighbours_Barrel.bin", OutputLevel=INFO)
+noiseRoot = TopoCaloNoisyCells("NoiseRoot", fileName="cellNoise_Barrel.root", OutputLevel=INFO)
+noiseBinary = TopoCaloNoisyCells("NoiseBinary", fileName="cellNoise_Barrel.bin", OutputLevel=INFO)
+
+from Configurables import TestCaloMapFiles
+compare = TestCaloMapFiles("compareMapFiles",
+                           neighboursRootTool=neighboursRoot,
+                           neighboursBinaryTool=neighboursBinary,
+                           noiseRootTool=noiseRoot,
+                           noiseBinaryTool=noiseBinary,
+                           neighboursRootFile="cellNeighbours_Barrel.root",
+                           neighboursBinaryFile="cellNeighbours_Barrel.bin",
+                           noiseRootFile="cellNoise_Barrel.root",
+                           noiseBinaryFile="cellNoise_Barrel.bin",
+                           OutputLevel=INFO)
+
+# ApplicationMgr
+from Configurables import ApplicationMgr
+ApplicationMgr( TopAlg = [compare],
+                EvtSel = 'NONE',
+                EvtMax   = 1,
+                ExtSvc = [],
+                OutputLevel=INFO
+)
@@ -13,6 +13,7 @@ geoservice = GeoSvc("GeoSvc", detectors=[ 'file:Detector/DetFCChhBaseline1/compa
 from Configurables import CreateFCChhCaloNeighbours
 neighbours = CreateFCChhCaloNeighbours("neighbours", 
                                        outputFileName="cellNeighbours_Barrel.root",
+                                       outputBinaryFileName="cellNeighbours_Barrel.bin",
                                        connectBarrels=True, 
                                        hCalRinner=2850,
                                        OutputLevel=INFO)
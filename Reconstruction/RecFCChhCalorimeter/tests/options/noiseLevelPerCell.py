@@ -52,6 +52,7 @@ noisePerCell = CreateFCChhCaloNoiseLevelMap("noisePerCell",
                                             ECalBarrelNoiseTool = ECalNoiseTool, 
                                             HCalBarrelNoiseTool = HCalNoiseTool,
                                             outputFileName="cellNoise_Barrel.root",
+                                            outputBinaryFileName="cellNoise_Barrel.bin",
                                             OutputLevel=DEBUG)
 
 # ApplicationMgr
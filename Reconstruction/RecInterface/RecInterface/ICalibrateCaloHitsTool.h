@@ -4,6 +4,9 @@
 // Gaudi
 #include "GaudiKernel/IAlgTool.h"
 
+#include <unordered_map>
+#include <vector>
+
 /** @class ICalibrateCaloHitsTool
  *
  *  Abstract interface to calorimeter hits calibration tool
@@ -14,9 +17,11 @@
 
 class ICalibrateCaloHitsTool : virtual public IAlgTool {
 public:
-  DeclareInterfaceID(ICalibrateCaloHitsTool, 1, 0);
+  DeclareInterfaceID(ICalibrateCaloHitsTool, 2, 0);
 
   virtual void calibrate(std::unordered_map<uint64_t, double>& aHits) = 0;
+  /// Calibrate cells stored in parallel arrays of cellIDs and energies
+  virtual void calibrate(const std::vector<uint64_t>& aCellIds, std::vector<double>& aEnergies) = 0;
 };
 
 #endif /* RECINTERFACE_ICALIBRATECALOHITSTOOL_H */
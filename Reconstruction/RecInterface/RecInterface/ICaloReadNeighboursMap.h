@@ -4,6 +4,10 @@
 // Gaudi
 #include "GaudiKernel/IAlgTool.h"
 
+// std
+#include <cstddef>
+#include <cstdint>
+
 /** @class ICaloReadNeighboursMap RecInterface/RecInterface/ICaloReadNeighboursMap.h ICaloReadNeighboursMap.h
  *
  *  Interface to the service creating a map for the calorimetry.
@@ -13,8 +17,22 @@
 
 class ICaloReadNeighboursMap : virtual public IAlgTool {
 public:
-  DeclareInterfaceID(ICaloReadNeighboursMap, 1, 0);
+  DeclareInterfaceID(ICaloReadNeighboursMap, 2, 0);
+
+  /// Read-only view of the neighbours of a cell, pointing into the map held by the tool
+  struct Neighbours {
+    const uint64_t* first = nullptr;
+    const uint64_t* last = nullptr;
+    const uint64_t* begin() const { return first; }
+    const uint64_t* end() const { return last; }
+    size_t size() const { return last - first; }
+    bool empty() const { return first == last; }
+  };
 
-  virtual std::vector<uint64_t>& neighbours(uint64_t aCellId) = 0;
+  /** Neighbours of a cell.
+   *   @param[in] aCellId, cellid of the cell of interest.
+   *   @return view of the cellIDs of the neighbours (empty if the cell is not in the map), valid as long as the map.
+   */
+  virtual Neighbours neighbours(uint64_t aCellId) const = 0;
 };
 #endif /* RECINTERFACE_ICALOREADNEIGHBOURSMAP_H */
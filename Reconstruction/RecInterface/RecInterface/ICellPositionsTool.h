@@ -27,6 +27,7 @@ public:
 
   virtual void getPositions(const fcc::CaloHitCollection& aCells, fcc::PositionedCaloHitCollection& outputColl) = 0;
 
+  /// Global position of the cell; the FCChh tools cache it per cellID (see CachedCellPositionsTool)
   virtual dd4hep::Position xyzPosition(const uint64_t& aCellId) const = 0;
   virtual int layerId(const uint64_t& aCellId) = 0;
 };
@@ -4,6 +4,9 @@
 // from Gaudi
 #include "GaudiKernel/IAlgTool.h"
 
+#include <unordered_map>
+#include <vector>
+
 /** @class INoiseCaloCellsTool
  *
  *  Abstract interface to calorimeter noise tool
@@ -14,10 +17,16 @@
 
 class INoiseCaloCellsTool : virtual public IAlgTool {
 public:
-  DeclareInterfaceID(INoiseCaloCellsTool, 1, 0);
+  DeclareInterfaceID(INoiseCaloCellsTool, 2, 0);
 
   virtual void addRandomCellNoise(std::unordered_map<uint64_t, double>& aCells) = 0;
   virtual void filterCellNoise(std::unordered_map<uint64_t, double>& aCells) = 0;
+  /// Add noise to cells stored in parallel arrays of cellIDs and energies
+  virtual void addRandomCellNoise(const std::vector<uint64_t>& aCellIds, std::vector<double>& aEnergies) = 0;
+  /// Copy the cells above threshold from parallel arrays of cellIDs and energies to the (cleared) output arrays,
+  /// preserving their order
+  virtual void filterCellNoise(const std::vector<uint64_t>& aCellIds, const std::vector<double>& aEnergies,
+                               std::vector<uint64_t>& aKeptCellIds, std::vector<double>& aKeptEnergies) = 0;
 };
 
 #endif /* RECINTERFACE_INOISECALOCELLSTOOL_H */
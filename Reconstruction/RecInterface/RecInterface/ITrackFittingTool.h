@@ -22,7 +22,8 @@ public:
 
   /// Create tracks out of `theHits`, using the seeding information in `seedmap`
   virtual std::pair<fcc::TrackCollection*, fcc::TrackStateCollection*>
-  fitTracks(const fcc::PositionedTrackHitCollection* theHits, std::multimap<unsigned int, unsigned int> seedmap) = 0;
+  fitTracks(const fcc::PositionedTrackHitCollection* theHits,
+            const std::multimap<unsigned int, unsigned int>& seedmap) = 0;
 };
 
 #endif /* RECINTERFACE_ITRACKFITTINGTOOL_H */
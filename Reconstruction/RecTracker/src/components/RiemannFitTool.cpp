@@ -34,59 +34,55 @@ StatusCode RiemannFitTool::initialize() {
 
 std::pair<fcc::TrackCollection*, fcc::TrackStateCollection*>
 RiemannFitTool::fitTracks(const fcc::PositionedTrackHitCollection* theHits,
-                          std::multimap<unsigned int, unsigned int> seedmap) {
+                          const std::multimap<unsigned int, unsigned int>& seedmap) {
 
-  constexpr unsigned int nhits = 22;
+  // the fit matrices have a fixed capacity (no dynamic allocation), further hits of a seed are ignored
+  constexpr unsigned int nhits = tricktrack::max_nop;
   fcc::TrackCollection* tracks = new fcc::TrackCollection();
   fcc::TrackStateCollection* trackStates = new fcc::TrackStateCollection();
 
-  decltype(seedmap.equal_range(0)) range;
-  for (auto it1 = seedmap.begin(); it1 != seedmap.end(); it1 = range.second) {
-    tricktrack::Matrix3xNd riemannHits = tricktrack::Matrix3xNd::Zero(3, nhits);
+  constexpr double l_cSpeed = Gaudi::Units::c_light / Gaudi::Units::m * Gaudi::Units::s;
+  const double l_bFfieldGeVCmC = m_Bz * l_cSpeed / pow(10, 9) / 100;  // conversion to GeV / cm / c
+  tricktrack::Matrix3xNd riemannHits(3, nhits);
+  for (auto it1 = seedmap.begin(); it1 != seedmap.end();) {
+    const unsigned int seedId = it1->first;
     auto track = tracks->create();
     auto trackState = trackStates->create();
+    riemannHits.resize(3, nhits);
     unsigned int hitCounter = 0;
-    // Get the range of the current TrackID
-    range = seedmap.equal_range(it1->first);
-
-    unsigned int l_trackId = (*theHits)[(*it1).second].core().bits;
-    // Go through the range
-    for (auto it2 = range.first; it2 != range.second; ++it2) {
-       //track.addhits((*theHits)[(*it2).second]); // TODO: reenable once new edm version available
-
-      std::cout <<"trackIds: " << l_trackId << "\t" << std::endl;
-      if (l_trackId != (*theHits)[(*it2).second].core().bits) {
+    unsigned int l_trackId = (*theHits)[it1->second].core().bits;
+    // Go through the range of the current TrackID
+    for (; it1 != seedmap.end() && it1->first == seedId; ++it1) {
+      //track.addhits((*theHits)[(*it1).second]); // TODO: reenable once new edm version available
+      const auto& hit = (*theHits)[it1->second];
+      if (l_trackId != hit.core().bits) {
         l_trackId = 0;
       }
-      auto pos = (*theHits)[(*it2).second].position();
       if (hitCounter < nhits) {
+        const auto& pos = hit.position();
         riemannHits.col(hitCounter) << pos.x, pos.y, pos.z;
+        hitCounter++;
       }
-      hitCounter++;
-    }
-    if (l_trackId > 0) {
-      track.bits(l_trackId);
-    } else {
-      track.bits(0);
     }
+    track.bits(l_trackId);
     if (m_doFit) {
-      if ((!m_fitOnlyPrimary) || (*it1).first == 1) {
-        auto hitDim = std::min(hitCounter, nhits);
-        auto resizedHits = riemannHits.block(0, 0, 3, hitDim);
+      if ((!m_fitOnlyPrimary) || seedId == 1) {
+        const auto hitDim = hitCounter;
+        // the storage of the matrix is fixed, shrinking it keeps the hits in place
+        riemannHits.conservativeResize(3, hitDim);
         tricktrack::Matrix3Nd hits_cov = m_hitRes * tricktrack::Matrix3Nd::Identity(3 * hitDim, 3 * hitDim);
-
-        constexpr double l_cSpeed = Gaudi::Units::c_light / Gaudi::Units::m * Gaudi::Units::s;
-        const double l_bFfieldGeVCmC = m_Bz * l_cSpeed / pow(10, 9) / 100;  // conversion to GeV / cm / c
-        auto h = tricktrack::Helix_fit(resizedHits, hits_cov, l_bFfieldGeVCmC, m_calcErrors, m_calcMultipleScattering);
-        debug() << "Fit parameters: " << h.par(0) << "\t" << h.par(1) << "\t" << h.par(2) << "\t" << h.par(3) << "\t"
-                << h.par(4) << endmsg;
-        debug() << "Fit charge: " << h.q << "\t"
-                << " chi_2 circle: " << h.chi2_circle << "\t"
-                << "chi_2 line:  " << h.chi2_line << endmsg;
-        auto upperCov = h.cov.triangularView<Eigen::Upper>();
-        debug() << " Fit covariance: "
-                << "\n"
-                << Eigen::MatrixXd(upperCov) << endmsg;
+        auto h = tricktrack::Helix_fit(riemannHits, hits_cov, l_bFfieldGeVCmC, m_calcErrors, m_calcMultipleScattering);
+        if (msgLevel(MSG::DEBUG)) {
+          debug() << "Fit parameters: " << h.par(0) << "\t" << h.par(1) << "\t" << h.par(2) << "\t" << h.par(3)
+                  << "\t" << h.par(4) << endmsg;
+          debug() << "Fit charge: " << h.q << "\t"
+                  << " chi_2 circle: " << h.chi2_circle << "\t"
+                  << "chi_2 line:  " << h.chi2_line << endmsg;
+          auto upperCov = h.cov.triangularView<Eigen::Upper>();
+          debug() << " Fit covariance: "
+                  << "\n"
+                  << Eigen::MatrixXd(upperCov) << endmsg;
+        }
         unsigned int coeffCounter = 0;
         /// write only unique values of 5 x 5 track parameter covariance to edm
         /// by convention upper triangle of matrix, flattened as below
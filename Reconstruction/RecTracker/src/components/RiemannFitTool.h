@@ -16,6 +16,10 @@
 
 /** @class RiemannFitTool
  * Track fitting tool implementation using tricktracks' Riemannfit
+ *
+ * The fit matrices of tricktrack have a fixed capacity of tricktrack::max_nop (8) hits, to avoid dynamic memory:
+ * only the first 8 hits of a seed (in the order of the seed map) are used in the fit, further hits are ignored.
+ * Tracks are created in the order of the seeds.
  */
 class RiemannFitTool : public GaudiTool, virtual public ITrackFittingTool {
 public:
@@ -25,7 +29,7 @@ public:
   virtual StatusCode finalize() override final;
   virtual std::pair<fcc::TrackCollection*, fcc::TrackStateCollection*>
   fitTracks(const fcc::PositionedTrackHitCollection* theHits,
-            std::multimap<unsigned int, unsigned int> seedmap) override final;
+            const std::multimap<unsigned int, unsigned int>& seedmap) override final;
 
 private:
   Gaudi::Property<double> m_Bz{this, "Bz", 4., "Field strength along Z"};
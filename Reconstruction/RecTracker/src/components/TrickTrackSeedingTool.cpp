@@ -12,10 +12,11 @@
 #include "tricktrack/HitChainMaker.h"
 #include "tricktrack/HitDoublets.h"
 #include "tricktrack/SpacePoint.h"
-#include "tricktrack/FKDTree.h"
-#include "tricktrack/FKDPoint.h"
 #include "tricktrack/TTPoint.h"
 
+#include <algorithm>
+#include <numeric>
+
 
 
 
@@ -43,53 +44,71 @@ StatusCode TrickTrackSeedingTool::initialize() {
   if (sc.isFailure()) {
     return sc;
   }
+  unsigned int numLayerPairs = m_layerGraph.theLayerPairs.size();
+  if ((!m_layerPairDeltaPhi.empty() && m_layerPairDeltaPhi.size() != numLayerPairs) ||
+      (!m_layerPairDeltaZ.empty() && m_layerPairDeltaZ.size() != numLayerPairs)) {
+    error() << "layerPairDeltaPhi and layerPairDeltaZ need one entry per layer pair (" << numLayerPairs << ")"
+            << endmsg;
+    return StatusCode::FAILURE;
+  }
 
 
   return sc;
 }
 
 
-tricktrack::HitDoublets<Hit>*   TrickTrackSeedingTool::findDoublets( std::vector<Hit> theInnerHits,  std::vector<Hit> theOuterHits) {
-
-  auto doublets = new tricktrack::HitDoublets<Hit>(theInnerHits, theOuterHits);
+void TrickTrackSeedingTool::findDoublets(tricktrack::HitDoublets<Hit>* doublets,
+                                         const std::vector<Hit>& theInnerHits,
+                                         const std::vector<Hit>& theOuterHits,
+                                         double theDeltaPhi,
+                                         double theDeltaZ) {
+  // sort the outer hits in phi
+  m_sortedOuterIndices.resize(theOuterHits.size());
+  std::iota(m_sortedOuterIndices.begin(), m_sortedOuterIndices.end(), 0);
+  std::sort(m_sortedOuterIndices.begin(), m_sortedOuterIndices.end(),
+            [&theOuterHits](unsigned int a, unsigned int b) { return theOuterHits[a].phi() < theOuterHits[b].phi(); });
+  m_sortedOuterPhi.resize(theOuterHits.size());
+  for (unsigned int j = 0; j < m_sortedOuterIndices.size(); ++j) {
+    m_sortedOuterPhi[j] = theOuterHits[m_sortedOuterIndices[j]].phi();
+  }
+  // collects the outer hits with phi in [phiLow, phiHigh]
+  auto addPhiRange = [this](double phiLow, double phiHigh) {
+    auto first = std::lower_bound(m_sortedOuterPhi.begin(), m_sortedOuterPhi.end(), phiLow);
+    auto last = std::upper_bound(first, m_sortedOuterPhi.end(), phiHigh);
+    for (auto it = first; it != last; ++it) {
+      m_doubletCandidates.push_back(m_sortedOuterIndices[std::distance(m_sortedOuterPhi.begin(), it)]);
+    }
+  };
 
-  // brute force doublet creation
   for (unsigned int i = 0; i < theInnerHits.size(); ++i) {
-    for(unsigned int j = 0; j < theOuterHits.size(); ++j) {
-      if ((M_PI - std::abs(std::abs(theOuterHits[j].phi() - theInnerHits[i].phi()) - M_PI)) < m_deltaPhi) {
-        if (std::abs(theOuterHits[j].z() - theInnerHits[i].z()) < m_deltaZ) {
-          if ( theOuterHits[j].t() - theInnerHits[i].t() > 0 && std::abs(theOuterHits[j].t() - theInnerHits[i].t()) < m_deltaT) {
-          doublets->add(i, j);
-        }
+    const double currentPhi = theInnerHits[i].phi();
+    m_doubletCandidates.clear();
+    if (theDeltaPhi >= M_PI) {
+      m_doubletCandidates = m_sortedOuterIndices;
+    } else {
+      // phi window, wrapped around at +-pi
+      const double phiLow = currentPhi - theDeltaPhi;
+      const double phiHigh = currentPhi + theDeltaPhi;
+      if (phiLow < -M_PI) {
+        addPhiRange(-M_PI, phiHigh);
+        addPhiRange(phiLow + 2 * M_PI, M_PI);
+      } else if (phiHigh > M_PI) {
+        addPhiRange(-M_PI, phiHigh - 2 * M_PI);
+        addPhiRange(phiLow, M_PI);
+      } else {
+        addPhiRange(phiLow, phiHigh);
       }
     }
-  }
-  }
- return doublets;
-}
-
-void TrickTrackSeedingTool::findDoublets(tricktrack::HitDoublets<Hit>* doublets, std::vector<tricktrack::TTPoint> theInnerHits,  tricktrack::FKDTree<tricktrack::TTPoint, double, 4> theOuterTree, std::vector<tricktrack::TTPoint> theOuterHits) {
-  // brute force doublet creation
-  for (unsigned int i = 0; i < theInnerHits.size(); ++i) {
-    double currentPhi = theInnerHits[i].phi();
-    double currentZ = theInnerHits[i].z();
-    double currentRho = theInnerHits[i].rho();
-    double currentT = theInnerHits[i].t();
-    
-    TTPoint minPoint(currentRho - m_deltaRho, currentPhi - m_deltaPhi, currentZ - m_deltaZ, currentT - m_deltaT,0);
-    TTPoint maxPoint(currentRho + m_deltaRho, currentPhi + m_deltaPhi,  currentZ + m_deltaZ, currentT + m_deltaT,0);
-
-    //std::vector<unsigned int> result;
-    //theOuterTree.search(minPoint, maxPoint, result);
-    for(unsigned int j = 0; j < theOuterHits.size(); ++j) {
-
-      if ((M_PI - std::abs(std::abs(theOuterHits[j].phi() - theInnerHits[i].phi()) - M_PI)) < m_deltaPhi) {
-        if (std::abs(theOuterHits[j].z() - theInnerHits[i].z()) < m_deltaZ) {
-          if ( theOuterHits[j].t() - theInnerHits[i].t() > 0 && std::abs(theOuterHits[j].t() - theInnerHits[i].t()) < m_deltaT) {
+    // keep the order of the outer hits, as in the comparison of all pairs
+    std::sort(m_doubletCandidates.begin(), m_doubletCandidates.end());
+    for (auto j : m_doubletCandidates) {
+      if ((M_PI - std::abs(std::abs(theOuterHits[j].phi() - currentPhi) - M_PI)) < theDeltaPhi) {
+        if (std::abs(theOuterHits[j].z() - theInnerHits[i].z()) < theDeltaZ) {
+          if (theOuterHits[j].t() - theInnerHits[i].t() > 0 &&
+              std::abs(theOuterHits[j].t() - theInnerHits[i].t()) < m_deltaT) {
             doublets->add(i, j);
           }
         }
-        
       }
     }
   }
@@ -130,27 +149,28 @@ TrickTrackSeedingTool::findSeeds(const fcc::PositionedTrackHitCollection* theHit
   debug() << "seedmap size: " << theSeeds.size() << endmsg;
 
   std::vector<std::vector<Hit>> layerPoints;
-  std::vector<tricktrack::FKDTree<tricktrack::TTPoint, double, 4>> layerTrees;
 
   // create vector of hits on each seeding layer
   for (unsigned int layerCounter = 0; layerCounter < numLayers; ++layerCounter) {
 
     layerPoints.emplace_back();
-    layerTrees.emplace_back();
     // set the indices the hit filter uses to select hits
     m_hitFilterTool->setIds(m_seedingLayerIndices[layerCounter].first, m_seedingLayerIndices[layerCounter].second);
     createBarrelSpacePoints(layerPoints.back(), theHits);
     debug() << "found " << layerPoints.back().size() << " points on Layer " << endmsg;
-    //layerTrees.back().build(layerPoints.back());
   }
 
   std::vector<HitDoublets<Hit>*> doublets;
   // go through layer pairs and create doublets
+  unsigned int layerPairCounter = 0;
   for (auto layerPair: m_layerGraph.theLayerPairs) {
     unsigned int innerLayerIndex = layerPair.theLayers[0];
     unsigned int outerLayerIndex = layerPair.theLayers[1];
+    double deltaPhi = m_layerPairDeltaPhi.empty() ? m_deltaPhi.value() : m_layerPairDeltaPhi[layerPairCounter];
+    double deltaZ = m_layerPairDeltaZ.empty() ? m_deltaZ.value() : m_layerPairDeltaZ[layerPairCounter];
+    ++layerPairCounter;
     auto doubletsOnLayerPair = new tricktrack::HitDoublets<Hit>(layerPoints[innerLayerIndex], layerPoints[outerLayerIndex]);
-    findDoublets(doubletsOnLayerPair, layerPoints[innerLayerIndex], layerTrees[outerLayerIndex], layerPoints[outerLayerIndex]);
+    findDoublets(doubletsOnLayerPair, layerPoints[innerLayerIndex], layerPoints[outerLayerIndex], deltaPhi, deltaZ);
 
     doublets.push_back(doubletsOnLayerPair);
     unsigned int numGoodDoublets = 0;
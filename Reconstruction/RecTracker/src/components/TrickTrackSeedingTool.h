@@ -15,7 +15,6 @@
 
 #include "tricktrack/SpacePoint.h"
 #include "tricktrack/CMGraph.h"
-#include "tricktrack/FKDTree.h"
 #include "tricktrack/TrackingRegion.h"
 #include "tricktrack/HitChainMaker.h"
 
@@ -38,10 +37,20 @@ public:
   virtual std::multimap<unsigned int, unsigned int> findSeeds(const fcc::PositionedTrackHitCollection* theHits) override final;
   void createBarrelSpacePoints(std::vector<tricktrack::TTPoint>& thePoints,
                                const fcc::PositionedTrackHitCollection* theHits);
-tricktrack::HitDoublets<tricktrack::TTPoint>*   findDoublets( std::vector<tricktrack::TTPoint> theInnerHits,  std::vector<tricktrack::TTPoint> theOuterHits);
-//void createKDTree( std::vector<Hit>& thePoints, std::pair<int, int> sIndex);
-void findDoublets(tricktrack::HitDoublets<tricktrack::TTPoint>* doublets, std::vector<tricktrack::TTPoint> theInnerHits,  tricktrack::FKDTree<tricktrack::TTPoint, double, 4> theOuterTree, std::vector<tricktrack::TTPoint> theOuterHits);
-
+  /** Create the doublets between two layers.
+   *  The outer hits are sorted in phi, so only the hits in the phi window (with wrap-around at +-pi)
+   *  around each inner hit are compared, instead of all pairs of hits.
+   *  @param[out] doublets doublets to which the pairs of inner and outer hit indices are added
+   *  @param[in] theInnerHits hits on the inner layer
+   *  @param[in] theOuterHits hits on the outer layer
+   *  @param[in] theDeltaPhi maximal phi distance of the hits
+   *  @param[in] theDeltaZ maximal z distance of the hits
+   */
+  void findDoublets(tricktrack::HitDoublets<tricktrack::TTPoint>* doublets,
+                    const std::vector<tricktrack::TTPoint>& theInnerHits,
+                    const std::vector<tricktrack::TTPoint>& theOuterHits,
+                    double theDeltaPhi,
+                    double theDeltaZ);
 
 private:
   /// system and layer ids for the inner barrel layer to be used for seeding
@@ -73,6 +82,12 @@ private:
   Gaudi::Property<double> m_deltaZ {this, "deltaZ", 150};
   /// Parameter for TrickTrack's doublet creation
   Gaudi::Property<double> m_deltaT {this, "deltaT", 1050.};
+  /// Parameter for TrickTrack's doublet creation, per layer pair (in the order of the layer graph)
+  /// overrides deltaPhi if not empty
+  Gaudi::Property<std::vector<double>> m_layerPairDeltaPhi {this, "layerPairDeltaPhi", {}};
+  /// Parameter for TrickTrack's doublet creation, per layer pair (in the order of the layer graph)
+  /// overrides deltaZ if not empty
+  Gaudi::Property<std::vector<double>> m_layerPairDeltaZ {this, "layerPairDeltaZ", {}};
 
   Gaudi::Property<bool> m_cleanHits {this, "cleanHits", true};
 
@@ -85,7 +100,12 @@ private:
   std::unique_ptr<tricktrack::HitChainMaker<tricktrack::TTPoint>> m_automaton;
   std::unique_ptr<tricktrack::TrackingRegion> m_trackingRegion;
   tricktrack::CMGraph m_layerGraph;
-  std::map<std::pair<int, int>, tricktrack::FKDTree<tricktrack::TTPoint, double, 4>> m_hitTrees;
+  /// Indices of the outer hits sorted in phi, reused for all layer pairs
+  std::vector<unsigned int> m_sortedOuterIndices;
+  /// Phi of the outer hits, in the order of m_sortedOuterIndices
+  std::vector<double> m_sortedOuterPhi;
+  /// Outer hit indices found in the phi window of an inner hit
+  std::vector<unsigned int> m_doubletCandidates;
 
 };
 
@@ -3,8 +3,11 @@
 
 #include "G4VUserEventInformation.hh"
 
+#include "datamodel/GenVertex.h"
+
+#include <functional>
 #include <iostream>
-#include <map>
+#include <unordered_map>
 
 class G4Track;
 namespace fcc {
@@ -16,7 +19,11 @@ class MCParticleCollection;
  *
  * Additional event information.
  *
- * Currently holds the particle history in form of edm particles and vertices
+ * Currently holds the particle history in form of edm particles and vertices.
+ * Secondaries created in the same interaction share their start vertex, which is also the end vertex of their
+ * mother (if saved). Particles without saved secondaries have no end vertex (endVertex().isAvailable() is false).
+ * The index of each saved particle is kept per Geant4 track ID, so that the mother of a particle
+ * can be found without searching the collection (see resolveParentIndices()).
  *
  * @author J. Lingemann
  */
@@ -24,8 +31,10 @@ class MCParticleCollection;
 namespace sim {
 class EventInformation : public G4VUserEventInformation {
 public:
-  /// Default constructor
-  EventInformation();
+  /** Constructor.
+   * @param[in] aExpectedParticles expected number of saved particles, used to reserve the lookup tables
+   */
+  explicit EventInformation(size_t aExpectedParticles = 0);
   /// Destructor
   virtual ~EventInformation() = default;
   /** Set external pointers to point at the particle and vertex collections.
@@ -35,16 +44,42 @@ public:
   void setCollections(fcc::GenVertexCollection*& aGenVertexCollection, fcc::MCParticleCollection*& aMcParticleCollection);
   /// Add a particle to be tracked in the EDM collections
   void addParticle(const G4Track* aSecondary);
+  /** Replace the Geant4 track ID of the mother (stored in the status) by the index of the mother in the particle
+   * collection, plus one. Particles whose mother was not saved get status 0.
+   * Has to be called before the collections are handed over with setCollections().
+   */
+  void resolveParentIndices();
+  /// Number of particles saved so far
+  size_t numParticles() const { return m_g4IdToParticleIndex.size(); }
 
   void Print() const {};
 
 private:
+  /// Start vertex of a secondary: the Geant4 track ID of the mother and the position and time of the interaction
+  struct VertexKey {
+    int parentId;
+    double x, y, z, t;
+    bool operator==(const VertexKey& aOther) const {
+      return parentId == aOther.parentId && x == aOther.x && y == aOther.y && z == aOther.z && t == aOther.t;
+    }
+  };
+  struct VertexKeyHash {
+    size_t operator()(const VertexKey& aKey) const {
+      size_t seed = std::hash<int>()(aKey.parentId);
+      for (double coordinate : {aKey.x, aKey.y, aKey.z, aKey.t}) {
+        seed ^= std::hash<double>()(coordinate) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+      }
+      return seed;
+    }
+  };
   /// Pointer to the vertex collection, ownership is intended to be transfered to SaveTool
   fcc::GenVertexCollection* m_genVertices;
   /// Pointer to the particle collection, ownership is intended to be transfered to SaveTool
   fcc::MCParticleCollection* m_mcParticles;
-  /// Map to get the edm end vertex id from a Geant4 unique particle ID
-  std::map<size_t, size_t> m_g4IdToEndVertexMap;
+  /// Map to get the index of the edm particle from a Geant4 unique particle ID
+  std::unordered_map<int, size_t> m_g4IdToParticleIndex;
+  /// Vertices already created, shared by all secondaries from the same interaction
+  std::unordered_map<VertexKey, fcc::GenVertex, VertexKeyHash> m_vertices;
 };
 }
 #endif /* define SIMG4COMMON_EVENTINFORMATION_H */
@@ -8,9 +8,11 @@
 #include "datamodel/MCParticleCollection.h"
 
 namespace sim {
-EventInformation::EventInformation() { 
+EventInformation::EventInformation(size_t aExpectedParticles) {
   m_genVertices = new fcc::GenVertexCollection();
   m_mcParticles = new fcc::MCParticleCollection();
+  m_g4IdToParticleIndex.reserve(aExpectedParticles);
+  m_vertices.reserve(aExpectedParticles);
 }
 
 void EventInformation::setCollections(fcc::GenVertexCollection*& aGenVertexCollection, fcc::MCParticleCollection*& aMCParticleCollection) {
@@ -20,6 +22,7 @@ void EventInformation::setCollections(fcc::GenVertexCollection*& aGenVertexColle
 }
 
 void EventInformation::addParticle(const G4Track* aSecondary) {
+  m_g4IdToParticleIndex[aSecondary->GetTrackID()] = m_mcParticles->size();
   auto edmParticle = m_mcParticles->create();
   auto g4mom = aSecondary->GetMomentum();
   auto g4energy = aSecondary->GetTotalEnergy();
@@ -34,26 +37,37 @@ void EventInformation::addParticle(const G4Track* aSecondary) {
   edmParticle.core().bits = g4ID;
   edmParticle.core().pdgId = aSecondary->GetDynamicParticle()->GetDefinition()->GetPDGEncoding();
 
-  auto g4EndPos = aSecondary->GetPosition();
-  auto edmEndVertex = m_genVertices->create();
-  edmEndVertex.x(g4EndPos.x() * sim::g42edm::length);
-  edmEndVertex.y(g4EndPos.y() * sim::g42edm::length);
-  edmEndVertex.z(g4EndPos.z() * sim::g42edm::length);
-  edmEndVertex.ctau(aSecondary->GetGlobalTime() * sim::g42edm::length);
-  edmParticle.endVertex(edmEndVertex);
-
-  /// @todo:
-  //size_t edmVtxId = edmEndVertex.getObjectID().index;
-  //m_g4IdToEndVertexMap[g4ID] = edmVtxId;
-
-  size_t motherID = aSecondary->GetParentID();
+  // the particle is added before it is tracked: its end vertex is only known if it produces saved secondaries
+  int motherID = aSecondary->GetParentID();
   auto g4StartPos = aSecondary->GetVertexPosition();
-  auto edmStartVertex = m_genVertices->create();
-  edmStartVertex.x(g4StartPos.x() * sim::g42edm::length);
-  edmStartVertex.y(g4StartPos.y() * sim::g42edm::length);
-  edmStartVertex.z(g4StartPos.z() * sim::g42edm::length);
-  edmStartVertex.ctau((aSecondary->GetGlobalTime() - aSecondary->GetLocalTime()) * sim::g42edm::length);
-  edmParticle.startVertex(edmStartVertex);
+  const VertexKey key{motherID, g4StartPos.x(), g4StartPos.y(), g4StartPos.z(),
+                      aSecondary->GetGlobalTime() - aSecondary->GetLocalTime()};
+  auto vertex = m_vertices.find(key);
+  if (vertex == m_vertices.end()) {
+    auto edmStartVertex = m_genVertices->create();
+    edmStartVertex.x(key.x * sim::g42edm::length);
+    edmStartVertex.y(key.y * sim::g42edm::length);
+    edmStartVertex.z(key.z * sim::g42edm::length);
+    edmStartVertex.ctau(key.t * sim::g42edm::length);
+    vertex = m_vertices.emplace(key, edmStartVertex).first;
+    // the latest interaction of the mother with saved secondaries is its end vertex
+    auto mother = m_g4IdToParticleIndex.find(motherID);
+    if (mother != m_g4IdToParticleIndex.end()) {
+      auto edmMother = m_mcParticles->at(mother->second);
+      if (!edmMother.endVertex().isAvailable() || edmMother.endVertex().ctau() < edmStartVertex.ctau()) {
+        edmMother.endVertex(edmStartVertex);
+      }
+    }
+  }
+  edmParticle.startVertex(vertex->second);
   edmParticle.core().status = motherID; // FCC convention for status of secondary sim particle
 }
+
+void EventInformation::resolveParentIndices() {
+  for (size_t iParticle = 0; iParticle < m_mcParticles->size(); ++iParticle) {
+    auto edmParticle = m_mcParticles->at(iParticle);
+    auto mother = m_g4IdToParticleIndex.find(edmParticle.core().status);
+    edmParticle.core().status = (mother != m_g4IdToParticleIndex.end()) ? mother->second + 1 : 0;
+  }
+}
 }
@@ -0,0 +1,380 @@
+#include "MTRunManager.h"
+
+// DD4hep
+#include "DDG4/Geant4Hits.h"
+
+// FCCSW
+#include "DetCommon/Geant4PreDigiTrackHit.h"
+#include "SimG4Common/ParticleInformation.h"
+#include "SimG4Interface/ISimG4MagneticFieldTool.h"
+
+// Geant
+#include "G4Event.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4THitsCollection.hh"
+#include "G4UserEventAction.hh"
+#include "G4VUserActionInitialization.hh"
+#include "G4VUserPrimaryGeneratorAction.hh"
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace sim {
+/** Copies of the hits of one sub-event, made on the worker thread.
+ *  Hits and hit collections are allocated from thread-local Geant4 allocators, so they cannot be deleted on the
+ *  master: the hits are copied by value and the worker deletes its own event.
+ */
+struct SubEventHits {
+  /// Type of the hits of a collection
+  enum class HitType { kNone, kUnknown, kCalorimeter, kTracker };
+  /// Hits of one collection, with the names needed to recreate it
+  struct Collection {
+    HitType type = HitType::kNone;
+    std::string detectorName;
+    std::string collectionName;
+    std::vector<dd4hep::sim::Geant4CalorimeterHit> caloHits;
+    std::vector<fcc::Geant4PreDigiTrackHit> trackHits;
+  };
+  /// Collections, indexed by collection ID
+  std::vector<Collection> collections;
+};
+}
+
+namespace {
+/// Copies the hits of the collection if it holds hits of type T
+template <class T>
+bool copyHits(G4VHitsCollection* aFrom, std::vector<T>& aTo) {
+  auto from = dynamic_cast<G4THitsCollection<T>*>(aFrom);
+  if (from == nullptr) return false;
+  aTo.reserve(from->entries());
+  for (auto hit : *from->GetVector()) {
+    aTo.push_back(*hit);
+  }
+  return true;
+}
+
+/// Largest Geant4 track ID of the copied hits of a sub-event
+unsigned int maxTrackId(const sim::SubEventHits& aSubEvent) {
+  unsigned int maxId = 0;
+  for (const auto& collection : aSubEvent.collections) {
+    for (const auto& hit : collection.trackHits) {
+      maxId = std::max(maxId, hit.trackId);
+    }
+    for (const auto& hit : collection.caloHits) {
+      for (const auto& contribution : hit.truth) {
+        maxId = std::max(maxId, static_cast<unsigned int>(contribution.trackID));
+      }
+    }
+  }
+  return maxId;
+}
+
+/// Shifts the track IDs of a hit by the offset of its sub-event
+void shiftTrackIds(fcc::Geant4PreDigiTrackHit& aHit, unsigned int aOffset) { aHit.trackId += aOffset; }
+void shiftTrackIds(dd4hep::sim::Geant4CalorimeterHit& aHit, unsigned int aOffset) {
+  for (auto& contribution : aHit.truth) {
+    contribution.trackID += aOffset;
+  }
+}
+
+/// Creates a hit collection on the current thread from the copied hits of all sub-events
+template <class T>
+G4THitsCollection<T>* mergeHits(const std::vector<std::unique_ptr<sim::SubEventHits>>& aSubEvents, size_t aCollId,
+                                std::vector<T> sim::SubEventHits::Collection::*aHits,
+                                const std::vector<unsigned int>& aTrackIdOffsets) {
+  const auto& first = aSubEvents.front()->collections[aCollId];
+  auto merged = new G4THitsCollection<T>(first.detectorName, first.collectionName);
+  for (size_t iSubEvent = 0; iSubEvent < aSubEvents.size(); ++iSubEvent) {
+    const auto& subEvent = aSubEvents[iSubEvent];
+    if (aCollId >= subEvent->collections.size()) continue;
+    for (const auto& hit : subEvent->collections[aCollId].*aHits) {
+      auto newHit = new T(hit);
+      shiftTrackIds(*newHit, aTrackIdOffsets[iSubEvent]);
+      merged->insert(newHit);
+    }
+  }
+  return merged;
+}
+
+/** Creates a calorimeter hit collection on the current thread from the copied hits of all sub-events.
+ *  If no cell appears twice within a sub-event, the sensitive detector aggregates the energy per cell:
+ *  the hits of a cell are then summed over the sub-events, as in the sequential simulation.
+ */
+G4THitsCollection<dd4hep::sim::Geant4CalorimeterHit>*
+mergeCalorimeterHits(const std::vector<std::unique_ptr<sim::SubEventHits>>& aSubEvents, size_t aCollId,
+                     const std::vector<unsigned int>& aTrackIdOffsets) {
+  bool aggregated = true;
+  for (const auto& subEvent : aSubEvents) {
+    if (aCollId >= subEvent->collections.size()) continue;
+    std::unordered_set<uint64_t> cells;
+    for (const auto& hit : subEvent->collections[aCollId].caloHits) {
+      if (!cells.insert(hit.cellID).second) {
+        aggregated = false;
+        break;
+      }
+    }
+    if (!aggregated) break;
+  }
+  if (!aggregated) {
+    return mergeHits(aSubEvents, aCollId, &sim::SubEventHits::Collection::caloHits, aTrackIdOffsets);
+  }
+  const auto& first = aSubEvents.front()->collections[aCollId];
+  auto merged = new G4THitsCollection<dd4hep::sim::Geant4CalorimeterHit>(first.detectorName, first.collectionName);
+  std::unordered_map<uint64_t, dd4hep::sim::Geant4CalorimeterHit*> hitOfCell;
+  for (size_t iSubEvent = 0; iSubEvent < aSubEvents.size(); ++iSubEvent) {
+    const auto& subEvent = aSubEvents[iSubEvent];
+    if (aCollId >= subEvent->collections.size()) continue;
+    for (const auto& hit : subEvent->collections[aCollId].caloHits) {
+      auto cellHit = hitOfCell.find(hit.cellID);
+      if (cellHit == hitOfCell.end()) {
+        auto newHit = new dd4hep::sim::Geant4CalorimeterHit(hit);
+        shiftTrackIds(*newHit, aTrackIdOffsets[iSubEvent]);
+        hitOfCell.emplace(hit.cellID, newHit);
+        merged->insert(newHit);
+      } else {
+        cellHit->second->energyDeposit += hit.energyDeposit;
+        for (auto contribution : hit.truth) {
+          contribution.trackID += aTrackIdOffsets[iSubEvent];
+          cellHit->second->truth.push_back(contribution);
+        }
+      }
+    }
+  }
+  return merged;
+}
+
+/// Worker primary generator: copies the primary vertices of the sub-event with the ID of the event
+class SubEventPrimaryGenerator : public G4VUserPrimaryGeneratorAction {
+public:
+  explicit SubEventPrimaryGenerator(const sim::MTRunManager& aManager) : m_manager(aManager) {}
+  virtual void GeneratePrimaries(G4Event* aEvent) final {
+    for (auto vertex : m_manager.subEventVertices(aEvent->GetEventID())) {
+      // vertices and particles are copied one by one, their copy constructors also copy the following ones
+      auto newVertex = new G4PrimaryVertex(vertex->GetPosition(), vertex->GetT0());
+      newVertex->SetWeight(vertex->GetWeight());
+      for (auto particle = vertex->GetPrimary(); particle != nullptr; particle = particle->GetNext()) {
+        auto newParticle = new G4PrimaryParticle(particle->GetPDGcode(), particle->GetPx(), particle->GetPy(),
+                                                 particle->GetPz());
+        newParticle->SetMass(particle->GetMass());
+        newParticle->SetCharge(particle->GetCharge());
+        newParticle->SetPolarization(particle->GetPolarization());
+        newParticle->SetProperTime(particle->GetProperTime());
+        // the information is owned and deleted by the particle: the link to the EDM particle is copied
+        auto info = dynamic_cast<const sim::ParticleInformation*>(particle->GetUserInformation());
+        if (info != nullptr) {
+          newParticle->SetUserInformation(new sim::ParticleInformation(info->mcParticle()));
+        }
+        newVertex->SetPrimary(newParticle);
+      }
+      aEvent->AddPrimaryVertex(newVertex);
+    }
+  }
+
+private:
+  const sim::MTRunManager& m_manager;
+};
+
+/// Worker event action: runs the user event action and hands the hit collections to the master
+class SubEventHitsCollector : public G4UserEventAction {
+public:
+  SubEventHitsCollector(sim::MTRunManager& aManager, G4UserEventAction* aUserAction)
+      : m_manager(aManager), m_userAction(aUserAction) {}
+  virtual ~SubEventHitsCollector() { delete m_userAction; }
+  virtual void BeginOfEventAction(const G4Event* aEvent) final {
+    if (m_userAction != nullptr) m_userAction->BeginOfEventAction(aEvent);
+  }
+  virtual void EndOfEventAction(const G4Event* aEvent) final {
+    if (m_userAction != nullptr) m_userAction->EndOfEventAction(aEvent);
+    // the sensitive detectors have finished the event: the hits are copied, the worker deletes the event and its hits
+    auto subEventHits = std::make_unique<sim::SubEventHits>();
+    auto hits = aEvent->GetHCofThisEvent();
+    if (hits != nullptr) {
+      subEventHits->collections.resize(hits->GetNumberOfCollections());
+      for (int iColl = 0; iColl < hits->GetNumberOfCollections(); ++iColl) {
+        auto from = hits->GetHC(iColl);
+        auto& to = subEventHits->collections[iColl];
+        if (from == nullptr) continue;
+        to.detectorName = from->GetSDname();
+        to.collectionName = from->GetName();
+        if (copyHits(from, to.caloHits)) {
+          to.type = sim::SubEventHits::HitType::kCalorimeter;
+        } else if (copyHits(from, to.trackHits)) {
+          to.type = sim::SubEventHits::HitType::kTracker;
+        } else {
+          to.type = sim::SubEventHits::HitType::kUnknown;
+        }
+      }
+    }
+    m_manager.addSubEventHits(aEvent->GetEventID(), std::move(subEventHits));
+  }
+
+private:
+  sim::MTRunManager& m_manager;
+  /// Event action of the user action initialization, owned
+  G4UserEventAction* m_userAction;
+};
+
+/// Wraps the user action initialization, adding the sub-event primaries and the hit collection hand-over
+class SubEventActionInitialization : public G4VUserActionInitialization {
+public:
+  SubEventActionInitialization(sim::MTRunManager& aManager, G4VUserActionInitialization* aUserInit)
+      : m_manager(aManager), m_userInit(aUserInit) {}
+  virtual ~SubEventActionInitialization() { delete m_userInit; }
+  virtual void BuildForMaster() const final {
+    if (m_userInit != nullptr) m_userInit->BuildForMaster();
+  }
+  virtual void Build() const final {
+    m_manager.initializeWorker();
+    if (m_userInit != nullptr) m_userInit->Build();
+    // the worker run manager now holds the user actions
+    auto userEventAction = const_cast<G4UserEventAction*>(G4RunManager::GetRunManager()->GetUserEventAction());
+    SetUserAction(new SubEventPrimaryGenerator(m_manager));
+    SetUserAction(new SubEventHitsCollector(m_manager, userEventAction));
+  }
+
+private:
+  sim::MTRunManager& m_manager;
+  G4VUserActionInitialization* m_userInit;
+};
+}
+
+namespace sim {
+MTRunManager::MTRunManager(unsigned int aNumThreads, unsigned int aVerticesPerSubEvent)
+    : G4MTRunManager(),
+      m_verticesPerSubEvent(aVerticesPerSubEvent),
+      m_fieldTool(nullptr),
+      m_currentEvent(nullptr),
+      m_msgSvc("MessageSvc", "MTRunManager"),
+      m_log(&(*m_msgSvc), "MTRunManager") {
+  G4MTRunManager::SetNumberOfThreads(aNumThreads);
+}
+
+MTRunManager::~MTRunManager() {}
+
+void MTRunManager::SetUserInitialization(G4VUserActionInitialization* aUserInit) {
+  G4MTRunManager::SetUserInitialization(new SubEventActionInitialization(*this, aUserInit));
+}
+
+void MTRunManager::setMagneticField(const ISimG4MagneticFieldTool* aFieldTool) { m_fieldTool = aFieldTool; }
+
+void MTRunManager::initializeWorker() const {
+  // the transportation manager of the worker thread has no field yet
+  if (m_fieldTool != nullptr) m_fieldTool->installField();
+}
+
+StatusCode MTRunManager::start() {
+  if (G4RunManager::ConfirmBeamOnCondition()) {
+    return StatusCode::SUCCESS;
+  } else {
+    return StatusCode::FAILURE;
+  }
+}
+
+StatusCode MTRunManager::processEvent(G4Event& aEvent) {
+  if (m_currentEvent != nullptr) {
+    m_log << MSG::ERROR << "Trying to process an event, but previous event has not been terminated" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  m_currentEvent = &aEvent;
+  // split the primary vertices into sub-events, independently of the number of threads
+  m_subEventVertices.clear();
+  unsigned int vertexCounter = 0;
+  for (auto vertex = aEvent.GetPrimaryVertex(); vertex != nullptr; vertex = vertex->GetNext()) {
+    if (vertexCounter % m_verticesPerSubEvent == 0) {
+      m_subEventVertices.emplace_back();
+    }
+    m_subEventVertices.back().push_back(vertex);
+    ++vertexCounter;
+  }
+  if (m_subEventVertices.empty()) {
+    return StatusCode::SUCCESS;
+  }
+  m_subEventHits.clear();
+  m_subEventHits.resize(m_subEventVertices.size());
+  // the seeds of each sub-event are drawn from the master engine before the event loop
+  G4MTRunManager::BeamOn(m_subEventVertices.size());
+  auto hits = mergeSubEventHits();
+  if (hits == nullptr) {
+    m_log << MSG::ERROR << "Unable to merge the hits of the sub-events" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  aEvent.SetHCofThisEvent(hits);
+  return StatusCode::SUCCESS;
+}
+
+const std::vector<const G4PrimaryVertex*>& MTRunManager::subEventVertices(int aSubEventId) const {
+  return m_subEventVertices[aSubEventId];
+}
+
+void MTRunManager::addSubEventHits(int aSubEventId, std::unique_ptr<SubEventHits> aHits) {
+  std::lock_guard<std::mutex> lock(m_subEventHitsMutex);
+  m_subEventHits[aSubEventId] = std::move(aHits);
+}
+
+G4HCofThisEvent* MTRunManager::mergeSubEventHits() {
+  for (const auto& hits : m_subEventHits) {
+    if (hits == nullptr) {
+      m_log << MSG::ERROR << "Hits of a sub-event were not returned by the worker threads" << endmsg;
+      m_subEventHits.clear();
+      return nullptr;
+    }
+  }
+  // collection IDs are the same in all threads, as the sensitive detectors are constructed in the same order
+  const size_t numCollections = m_subEventHits.front()->collections.size();
+  // track IDs restart at 1 in each sub-event, they are shifted to be unique in the event
+  std::vector<unsigned int> trackIdOffsets(m_subEventHits.size(), 0);
+  for (size_t iSubEvent = 1; iSubEvent < m_subEventHits.size(); ++iSubEvent) {
+    trackIdOffsets[iSubEvent] = trackIdOffsets[iSubEvent - 1] + maxTrackId(*m_subEventHits[iSubEvent - 1]);
+  }
+  // created on the master thread, hence allocated from the master allocators and deleted with the event
+  auto merged = new G4HCofThisEvent(numCollections);
+  for (size_t iColl = 0; iColl < numCollections; ++iColl) {
+    // merged in the order of the sub-events, so the hits order does not depend on the threads
+    switch (m_subEventHits.front()->collections[iColl].type) {
+    case SubEventHits::HitType::kCalorimeter:
+      merged->AddHitsCollection(iColl, mergeCalorimeterHits(m_subEventHits, iColl, trackIdOffsets));
+      break;
+    case SubEventHits::HitType::kTracker:
+      merged->AddHitsCollection(iColl,
+                                mergeHits(m_subEventHits, iColl, &SubEventHits::Collection::trackHits, trackIdOffsets));
+      break;
+    case SubEventHits::HitType::kUnknown:
+      m_log << MSG::WARNING << "Unknown hit type in collection "
+            << m_subEventHits.front()->collections[iColl].collectionName << ", hits are lost" << endmsg;
+      break;
+    case SubEventHits::HitType::kNone:
+      break;
+    }
+  }
+  m_subEventHits.clear();
+  return merged;
+}
+
+StatusCode MTRunManager::retrieveEvent(G4Event*& aEvent) {
+  if (m_currentEvent == nullptr) {
+    m_log << MSG::ERROR << "Trying to retrieve an event, but no event has been processed by Geant" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  aEvent = m_currentEvent;
+  return StatusCode::SUCCESS;
+}
+
+StatusCode MTRunManager::terminateEvent() {
+  if (m_currentEvent == nullptr) {
+    m_log << MSG::ERROR << "Trying to terminate an event, but no event has been processed by Geant" << endmsg;
+    return StatusCode::FAILURE;
+  }
+  // deletes the primaries and the merged hit collections, all allocated on this thread
+  delete m_currentEvent;
+  m_currentEvent = nullptr;
+  m_subEventVertices.clear();
+  return StatusCode::SUCCESS;
+}
+
+void MTRunManager::finalize() {
+  // each event is a complete run, the worker threads are terminated in ~G4MTRunManager()
+}
+}
@@ -0,0 +1,124 @@
+#ifndef SIMG4COMPONENTS_MTRUNMANAGER_H
+#define SIMG4COMPONENTS_MTRUNMANAGER_H
+
+// Geant4
+#include "G4MTRunManager.hh"
+
+// Gaudi
+#include "GaudiKernel/IMessageSvc.h"
+#include "GaudiKernel/MsgStream.h"
+#include "GaudiKernel/ServiceHandle.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class G4HCofThisEvent;
+class G4PrimaryVertex;
+class G4VUserActionInitialization;
+class ISimG4MagneticFieldTool;
+
+/** @class MTRunManager SimG4Components/src/MTRunManager.h MTRunManager.h
+ *
+ *  Multithreaded counterpart of sim::RunManager.
+ *  Each event passed by Gaudi is split into sub-events of a fixed number of primary vertices,
+ *  which are simulated in parallel by the Geant4 worker threads (one Geant4 run per Gaudi event).
+ *  The hits of the sub-events are copied on the worker threads and merged by the master into new hit collections
+ *  of the Gaudi event, so that the output tools see a single G4Event with all hits.
+ *  Geant4 track IDs restart at 1 in each sub-event: the track IDs of the merged hits are shifted by the largest
+ *  track ID of the hits of the previous sub-events. Calorimeter hits of a cell are summed over the sub-events
+ *  if the sensitive detector aggregates the energy per cell (no cell appears twice within a sub-event), otherwise
+ *  the hits of all steps are kept, as in the sequential simulation.
+ *  Hits are allocated from thread-local Geant4 allocators, so no hit or collection is deleted on another thread
+ *  than the one that created it.
+ *  The random seeds of the sub-events are drawn from the master engine (seeded from Gaudi) in sub-event order,
+ *  hence the result does not depend on the number of threads.
+ *  The magnetic field is installed on each worker thread, as the Geant4 field managers are thread-local.
+ *  The primary particles are copied with their link to the EDM particle (sim::ParticleInformation), but without
+ *  their predefined daughters. Only the hit collections are returned: the event user information and the fast
+ *  simulation information stay on the worker threads, hence SimG4Svc rejects the particle history and the fast
+ *  simulation in this mode.
+ */
+
+namespace sim {
+struct SubEventHits;
+
+class MTRunManager : public G4MTRunManager {
+public:
+  /** Constructor.
+   *  @param[in] aNumThreads number of Geant4 worker threads
+   *  @param[in] aVerticesPerSubEvent number of primary vertices simulated together in one sub-event
+   */
+  MTRunManager(unsigned int aNumThreads, unsigned int aVerticesPerSubEvent);
+  /// Destructor.
+  ~MTRunManager();
+  using G4MTRunManager::SetUserInitialization;
+  /** Set the user actions.
+   *  The actions are wrapped so that the workers take their primaries from the sub-events and return their hits.
+   *  @param[in] aUserInit user action initialization, deleted in ~G4RunManager (through the wrapper)
+   */
+  virtual void SetUserInitialization(G4VUserActionInitialization* aUserInit) override;
+  /** Set the magnetic field, installed on each worker thread when its user actions are built.
+   *  @param[in] aFieldTool tool of the magnetic field, not owned
+   */
+  void setMagneticField(const ISimG4MagneticFieldTool* aFieldTool);
+  /// Initialization of a worker thread, called from the worker threads
+  void initializeWorker() const;
+  /** Initialization.
+   *  Checks on the state of Geant4, the runs are started for each event in processEvent().
+   *  @returns the status code
+   */
+  StatusCode start();
+  /** Processing of the event.
+   *  Splits the event into sub-events, simulates them on the worker threads and merges their hit collections.
+   *  The run manager takes ownership of the event, deleted in terminateEvent().
+   *  @warning Each call to processEvent() should be followed by a call to terminateEvent().
+   *  @param[in] aEvent a generated event to be processed in a simulation
+   *  @returns the status code
+   */
+  StatusCode processEvent(G4Event& aEvent);
+  /** Retrieves an event.
+   *  The lifetime of the pointer to G4Event ends when method terminateEvent() is called.
+   *  @param[out] aEvent a processed event, holding the merged hit collections
+   *  @returns the status code
+   */
+  StatusCode retrieveEvent(G4Event*& aEvent);
+  /** Termination of the event processing.
+   *  @returns the status code
+   */
+  StatusCode terminateEvent();
+  /// Finalization.
+  void finalize();
+  /** Primary vertices of a sub-event, called from the worker threads.
+   *  @param[in] aSubEventId index of the sub-event (event ID in the current run)
+   */
+  const std::vector<const G4PrimaryVertex*>& subEventVertices(int aSubEventId) const;
+  /** Hand the copied hits of a simulated sub-event to the master, called from the worker threads.
+   *  @param[in] aSubEventId index of the sub-event (event ID in the current run)
+   *  @param[in] aHits copies of the hits of the sub-event
+   */
+  void addSubEventHits(int aSubEventId, std::unique_ptr<SubEventHits> aHits);
+
+private:
+  /// Create the hit collections of the event from the hits of all sub-events
+  G4HCofThisEvent* mergeSubEventHits();
+  /// Number of primary vertices per sub-event
+  unsigned int m_verticesPerSubEvent;
+  /// Magnetic field installed on the worker threads (not owned)
+  const ISimG4MagneticFieldTool* m_fieldTool;
+  /// Primary vertices of the sub-events of the current event (owned by the current event)
+  std::vector<std::vector<const G4PrimaryVertex*>> m_subEventVertices;
+  /// Copied hits of the sub-events of the current event
+  std::vector<std::unique_ptr<SubEventHits>> m_subEventHits;
+  /// Protects m_subEventHits filled by the worker threads
+  std::mutex m_subEventHitsMutex;
+  /// The event being processed
+  G4Event* m_currentEvent;
+  /// Message Service
+  ServiceHandle<IMessageSvc> m_msgSvc;
+  /// Message Stream
+  MsgStream m_log;
+};
+}
+
+#endif /* SIMG4COMPONENTS_MTRUNMANAGER_H */
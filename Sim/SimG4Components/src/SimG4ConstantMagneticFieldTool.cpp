@@ -21,6 +21,8 @@
 #include "G4NystromRK4.hh"
 #include "G4PropagatorInField.hh"
 
+#include <algorithm>
+
 // Declaration of the Tool
 DECLARE_COMPONENT(SimG4ConstantMagneticFieldTool)
 
@@ -39,29 +41,41 @@ StatusCode SimG4ConstantMagneticFieldTool::initialize() {
   if (sc.isFailure()) return sc;
 
   if (m_fieldOn) {
-    G4TransportationManager* transpManager = G4TransportationManager::GetTransportationManager();
-    G4FieldManager* fieldManager = transpManager->GetFieldManager();
-    G4PropagatorInField* propagator = transpManager->GetPropagatorInField();
-
+    const std::vector<std::string> steppers = {"HelixImplicitEuler", "HelixSimpleRunge", "HelixExplicitEuler",
+                                               "NystromRK4", "ClassicalRK4"};
+    if (std::find(steppers.begin(), steppers.end(), m_integratorStepper.value()) == steppers.end()) {
+      // reported once here, stepper() is also called on the worker threads
+      error() << "Stepper " << m_integratorStepper.value() << " not available! using NystromRK4!" << endmsg;
+    }
     // The field manager keeps an observing pointer to the field, ownership stays with this tool. (Cleaned up in dtor)
+    // The field is read-only, hence shared by the field managers of all threads.
     m_field =
         new sim::ConstantField(m_fieldComponentX, m_fieldComponentY, m_fieldComponentZ, m_fieldRadMax, m_fieldZMax);
-    fieldManager->SetDetectorField(m_field);
+    installField();
+  }
+  return sc;
+}
 
-    fieldManager->CreateChordFinder(m_field);
-    G4ChordFinder* chordFinder = fieldManager->GetChordFinder();
-    // dynamic cast needed temporarily for compatibility with Geant4 10.4
-    G4MagInt_Driver* l_magDriver =  dynamic_cast<G4MagInt_Driver*>(chordFinder->GetIntegrationDriver());
-    l_magDriver->RenewStepperAndAdjust(stepper(m_integratorStepper, m_field)); 
+void SimG4ConstantMagneticFieldTool::installField() const {
+  if (m_field == nullptr) return;
+  G4TransportationManager* transpManager = G4TransportationManager::GetTransportationManager();
+  G4FieldManager* fieldManager = transpManager->GetFieldManager();
+  G4PropagatorInField* propagator = transpManager->GetPropagatorInField();
 
-    propagator->SetLargestAcceptableStep(m_maxStep);
+  fieldManager->SetDetectorField(m_field);
 
-    if (m_deltaChord > 0) fieldManager->GetChordFinder()->SetDeltaChord(m_deltaChord);
-    if (m_deltaOneStep > 0) fieldManager->SetDeltaOneStep(m_deltaOneStep);
-    if (m_minEps > 0) fieldManager->SetMinimumEpsilonStep(m_minEps);
-    if (m_maxEps > 0) fieldManager->SetMaximumEpsilonStep(m_maxEps);
-  }
-  return sc;
+  fieldManager->CreateChordFinder(m_field);
+  G4ChordFinder* chordFinder = fieldManager->GetChordFinder();
+  // dynamic cast needed temporarily for compatibility with Geant4 10.4
+  G4MagInt_Driver* l_magDriver =  dynamic_cast<G4MagInt_Driver*>(chordFinder->GetIntegrationDriver());
+  l_magDriver->RenewStepperAndAdjust(stepper(m_integratorStepper, m_field));
+
+  propagator->SetLargestAcceptableStep(m_maxStep);
+
+  if (m_deltaChord > 0) fieldManager->GetChordFinder()->SetDeltaChord(m_deltaChord);
+  if (m_deltaOneStep > 0) fieldManager->SetDeltaOneStep(m_deltaOneStep);
+  if (m_minEps > 0) fieldManager->SetMinimumEpsilonStep(m_minEps);
+  if (m_maxEps > 0) fieldManager->SetMaximumEpsilonStep(m_maxEps);
 }
 
 StatusCode SimG4ConstantMagneticFieldTool::finalize() {
@@ -83,8 +97,6 @@ G4MagIntegratorStepper* SimG4ConstantMagneticFieldTool::stepper(const std::strin
     return new G4NystromRK4(fEquation);
   else if (name == "ClassicalRK4")
     return new G4ClassicalRK4(fEquation);
-  else {
-    error() << "Stepper " << name << " not available! returning NystromRK4!" << endmsg;
+  else
     return new G4NystromRK4(fEquation);
-  }
 }
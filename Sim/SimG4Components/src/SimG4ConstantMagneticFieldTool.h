@@ -46,6 +46,9 @@ public:
   /// @returns pointer to G4MagneticField
   virtual const G4MagneticField* field() const final;
 
+  /// Install the field, the chord finder and the stepper in the field manager of the calling thread
+  virtual void installField() const final;
+
   /// Get the stepper
   /// @returns pointer to G4MagIntegratorStepper (ownership is transferred to the caller)
   G4MagIntegratorStepper* stepper(const std::string&, G4MagneticField*) const;
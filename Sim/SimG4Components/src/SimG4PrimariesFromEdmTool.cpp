@@ -15,6 +15,9 @@
 // Geant4
 #include "G4Event.hh"
 
+#include <cmath>
+#include <unordered_map>
+
 // Declaration of the Tool
 DECLARE_COMPONENT(SimG4PrimariesFromEdmTool)
 
@@ -27,25 +30,56 @@ SimG4PrimariesFromEdmTool::SimG4PrimariesFromEdmTool(const std::string& type,
 
 SimG4PrimariesFromEdmTool::~SimG4PrimariesFromEdmTool() {}
 
-StatusCode SimG4PrimariesFromEdmTool::initialize() { return GaudiTool::initialize(); }
+StatusCode SimG4PrimariesFromEdmTool::initialize() {
+  if (GaudiTool::initialize().isFailure()) {
+    return StatusCode::FAILURE;
+  }
+  if (m_applyAcceptanceCut) {
+    info() << "Only particles with |eta| < " << m_etaMax << " and pT > " << m_ptMin
+           << " GeV are passed to Geant4" << endmsg;
+  }
+  return StatusCode::SUCCESS;
+}
 
 G4Event* SimG4PrimariesFromEdmTool::g4Event() {
   auto theEvent = new G4Event();
   const fcc::MCParticleCollection* mcparticles = m_genParticles.get();
+  // G4PrimaryVertex for each EDM vertex, identified by its collection ID and index
+  std::unordered_map<uint64_t, G4PrimaryVertex*> g4Vertices;
+  unsigned int nSkipped = 0;
   for (const auto& mcparticle : *mcparticles) {
-    const fcc::ConstGenVertex& v = mcparticle.startVertex();
-    G4PrimaryVertex* g4Vertex = new G4PrimaryVertex(v.x() * sim::edm2g4::length,
-                                                    v.y() * sim::edm2g4::length,
-                                                    v.z() * sim::edm2g4::length,
-                                                    v.ctau() / Gaudi::Units::c_light  * sim::edm2g4::length);
     const fcc::BareParticle& mccore = mcparticle.core();
+    if (m_applyAcceptanceCut) {
+      const double pt = std::hypot(mccore.p4.px, mccore.p4.py);
+      if (pt <= m_ptMin || pt == 0 || std::abs(std::asinh(mccore.p4.pz / pt)) >= m_etaMax) {
+        ++nSkipped;
+        continue;
+      }
+    }
+    const fcc::ConstGenVertex& v = mcparticle.startVertex();
+    const podio::ObjectID vertexId = v.getObjectID();
+    const uint64_t vertexKey = (uint64_t(uint32_t(vertexId.collectionID)) << 32) | uint32_t(vertexId.index);
+    G4PrimaryVertex*& g4Vertex = g4Vertices[vertexKey];
+    if (g4Vertex == nullptr) {
+      g4Vertex = new G4PrimaryVertex(v.x() * sim::edm2g4::length,
+                                     v.y() * sim::edm2g4::length,
+                                     v.z() * sim::edm2g4::length,
+                                     v.ctau() / Gaudi::Units::c_light * sim::edm2g4::length);
+      theEvent->AddPrimaryVertex(g4Vertex);
+    }
     G4PrimaryParticle* g4Particle = new G4PrimaryParticle(mccore.pdgId,
                                                           mccore.p4.px * sim::edm2g4::energy,
                                                           mccore.p4.py * sim::edm2g4::energy,
                                                           mccore.p4.pz * sim::edm2g4::energy);
     g4Particle->SetUserInformation(new sim::ParticleInformation(mcparticle));
     g4Vertex->SetPrimary(g4Particle);
-    theEvent->AddPrimaryVertex(g4Vertex);
+  }
+  if (msgLevel(MSG::DEBUG)) {
+    debug() << "Created " << g4Vertices.size() << " primary vertices from " << mcparticles->size() << " particles";
+    if (m_applyAcceptanceCut) {
+      debug() << ", " << nSkipped << " particles outside of the acceptance";
+    }
+    debug() << endmsg;
   }
   return theEvent;
 }
@@ -18,6 +18,8 @@ class MCParticleCollection;
 /** @class SimG4PrimariesFromEdmTool SimG4PrimariesFromEdmTool.h "SimG4PrimariesFromEdmTool.h"
 *
 *  Tool to translate an EDM MCParticleCollection into a G4Event
+*  Particles sharing the same EDM start vertex are attached to a single G4PrimaryVertex.
+*  Optionally (\b'applyAcceptanceCut'), particles outside of the eta / pT acceptance are not passed to Geant4.
 *
 *  @author A. Zaborowska, J. Lingemann, A. Dell'Acqua
 *  @date   2016-01-11
@@ -38,6 +40,13 @@ public:
 private:
   /// Handle for the EDM MC particles to be read
   DataHandle<fcc::MCParticleCollection> m_genParticles{"allGenParticles", Gaudi::DataHandle::Reader, this};
+  /// Flag whether particles outside of the acceptance are skipped
+  Gaudi::Property<bool> m_applyAcceptanceCut{this, "applyAcceptanceCut", false,
+                                             "Skip particles outside of the eta / pT acceptance"};
+  /// Maximal absolute pseudorapidity of the particles passed to Geant4
+  Gaudi::Property<double> m_etaMax{this, "etaMax", 6., "Maximal absolute eta of the particles passed to Geant4"};
+  /// Minimal transverse momentum of the particles passed to Geant4 (in GeV)
+  Gaudi::Property<double> m_ptMin{this, "ptMin", 0., "Minimal pT of the particles passed to Geant4 [GeV]"};
 };
 
 #endif
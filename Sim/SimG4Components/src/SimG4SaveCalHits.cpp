@@ -6,6 +6,7 @@
 
 // Geant4
 #include "G4Event.hh"
+#include "G4THitsCollection.hh"
 
 // datamodel
 #include "datamodel/CaloHitCollection.h"
@@ -53,31 +54,56 @@ StatusCode SimG4SaveCalHits::finalize() { return GaudiTool::finalize(); }
 
 StatusCode SimG4SaveCalHits::saveOutput(const G4Event& aEvent) {
   G4HCofThisEvent* collections = aEvent.GetHCofThisEvent();
-  G4VHitsCollection* collect;
-  dd4hep::sim::Geant4CalorimeterHit* hit;
   if (collections != nullptr) {
+    if (!m_collectionIDsResolved) {
+      resolveCollectionIDs(*collections);
+    }
     auto edmPositioned = m_positionedCaloHits.createAndPut();
     auto edmHits = m_caloHits.createAndPut();
-    for (int iter_coll = 0; iter_coll < collections->GetNumberOfCollections(); iter_coll++) {
-      collect = collections->GetHC(iter_coll);
-      if (std::find(m_readoutNames.begin(), m_readoutNames.end(), collect->GetName()) != m_readoutNames.end()) {
-        size_t n_hit = collect->GetSize();
-        debug() << "\t" << n_hit << " hits are stored in a collection #" << iter_coll << ": " << collect->GetName()
-                << endmsg;
-        for (size_t iter_hit = 0; iter_hit < n_hit; iter_hit++) {
-          hit = dynamic_cast<dd4hep::sim::Geant4CalorimeterHit*>(collect->GetHit(iter_hit));
-          auto edmHit = edmHits->create();
-          auto& edmHitCore = edmHit.core();
-          edmHitCore.cellId = hit->cellID;
-          edmHitCore.energy = hit->energyDeposit * sim::g42edm::energy;
-          auto position = fcc::Point();
-          position.x = hit->position.x() * sim::g42edm::length;
-          position.y = hit->position.y() * sim::g42edm::length;
-          position.z = hit->position.z() * sim::g42edm::length;
-          auto posHit = edmPositioned->create(position, edmHitCore);
-        }
+    for (int iter_coll : m_collectionIDs) {
+      // the type of the collection was checked when resolving the IDs
+      auto collect =
+          static_cast<G4THitsCollection<dd4hep::sim::Geant4CalorimeterHit>*>(collections->GetHC(iter_coll));
+      if (collect == nullptr) {
+        continue;
+      }
+      if (msgLevel(MSG::DEBUG)) {
+        debug() << "\t" << collect->entries() << " hits are stored in a collection #" << iter_coll << ": "
+                << collect->GetName() << endmsg;
+      }
+      for (const auto hit : *collect->GetVector()) {
+        auto edmHit = edmHits->create();
+        auto& edmHitCore = edmHit.core();
+        edmHitCore.cellId = hit->cellID;
+        edmHitCore.energy = hit->energyDeposit * sim::g42edm::energy;
+        fcc::Point position;
+        position.x = hit->position.x() * sim::g42edm::length;
+        position.y = hit->position.y() * sim::g42edm::length;
+        position.z = hit->position.z() * sim::g42edm::length;
+        edmPositioned->create(position, edmHitCore);
       }
     }
   }
   return StatusCode::SUCCESS;
 }
+
+void SimG4SaveCalHits::resolveCollectionIDs(G4HCofThisEvent& aCollections) {
+  // collection IDs are fixed once the sensitive detectors are constructed, they do not change between events
+  m_collectionIDs.clear();
+  for (int iter_coll = 0; iter_coll < aCollections.GetNumberOfCollections(); iter_coll++) {
+    auto collect = aCollections.GetHC(iter_coll);
+    if (collect == nullptr) {
+      continue;
+    }
+    if (std::find(m_readoutNames.begin(), m_readoutNames.end(), collect->GetName()) == m_readoutNames.end()) {
+      continue;
+    }
+    if (dynamic_cast<G4THitsCollection<dd4hep::sim::Geant4CalorimeterHit>*>(collect) == nullptr) {
+      warning() << "Collection " << collect->GetName() << " does not hold calorimeter hits, it will not be saved"
+                << endmsg;
+      continue;
+    }
+    m_collectionIDs.push_back(iter_coll);
+  }
+  m_collectionIDsResolved = true;
+}
@@ -27,6 +27,9 @@ SimG4SaveParticleHistory::SimG4SaveParticleHistory(const std::string& aType, con
 
 StatusCode SimG4SaveParticleHistory::saveOutput(const G4Event& aEvent) {
   auto evtinfo = dynamic_cast<sim::EventInformation*>(aEvent.GetUserInformation());
+  if (m_resolveParentIndices) {
+    evtinfo->resolveParentIndices();
+  }
   // take over ownership of particle and vertex collections
   evtinfo->setCollections(m_genVertexColl, m_mcParticleColl);
   info() << "Saved " << m_mcParticleColl->size() << " particles from Geant4 history." << endmsg;
@@ -24,6 +24,8 @@ class EventInformation;
 /** @class SimG4SaveParticleHistory SimG4Components/src/SimG4SaveParticleHistory.h SimG4SaveParticleHistory.h
  *
  *  This tool allows to save the particle history of particles decaying during the simulation
+ *  By default the status of a particle holds the Geant4 track ID of its mother. If \b'resolveParentIndices' is set,
+ *  it holds instead the index of the mother in the saved collection plus one (0 if the mother was not saved).
  *
  *  @author J. Lingemann
  *  @author V. Volkl
@@ -46,6 +48,10 @@ private:
   DataHandle<fcc::MCParticleCollection> m_mcParticles{"sim/secondaries", Gaudi::DataHandle::Writer, this};
   /// Handle for the vertex collection to create
   DataHandle<fcc::GenVertexCollection> m_genVertices{"sim/secondaryVertices", Gaudi::DataHandle::Writer, this};
+  /// Flag whether the status of the particles is replaced by the index of their mother
+  Gaudi::Property<bool> m_resolveParentIndices{
+      this, "resolveParentIndices", false,
+      "Store in the status the index of the mother in the collection plus one, instead of its Geant4 track ID"};
   /// Pointer to the vertex collection, ownership should be handled in a algorithm / tool
   fcc::GenVertexCollection* m_genVertexColl;
   /// Pointer to the particle collection, ownership should be handled in a algorithm / tool
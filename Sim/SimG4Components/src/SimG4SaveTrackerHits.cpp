@@ -7,6 +7,7 @@
 
 // Geant4
 #include "G4Event.hh"
+#include "G4THitsCollection.hh"
 
 // datamodel
 #include "datamodel/PositionedTrackHitCollection.h"
@@ -57,43 +58,65 @@ StatusCode SimG4SaveTrackerHits::finalize() { return GaudiTool::finalize(); }
 
 StatusCode SimG4SaveTrackerHits::saveOutput(const G4Event& aEvent) {
   G4HCofThisEvent* collections = aEvent.GetHCofThisEvent();
-  G4VHitsCollection* collect;
-  fcc::Geant4PreDigiTrackHit* hit;
   if (collections != nullptr) {
+    if (!m_collectionIDsResolved) {
+      resolveCollectionIDs(*collections);
+    }
     fcc::PositionedTrackHitCollection* edmPositions = m_positionedTrackHits.createAndPut();
     fcc::TrackHitCollection* edmHits = m_trackHits.createAndPut();
     fcc::DigiTrackHitAssociationCollection* edmDigiHits = m_digiTrackHits.createAndPut();
-    for (int iter_coll = 0; iter_coll < collections->GetNumberOfCollections(); iter_coll++) {
-      collect = collections->GetHC(iter_coll);
-      if (std::find(m_readoutNames.begin(), m_readoutNames.end(), collect->GetName()) != m_readoutNames.end()) {
-        size_t n_hit = collect->GetSize();
-        info() << "\t" << n_hit << " hits are stored in a tracker collection #" << iter_coll << ": "
-               << collect->GetName() << endmsg;
-        for (size_t iter_hit = 0; iter_hit < n_hit; iter_hit++) {
-          hit = dynamic_cast<fcc::Geant4PreDigiTrackHit*>(collect->GetHit(iter_hit));
-          fcc::TrackHit edmHit = edmHits->create();
-          fcc::BareHit& edmHitCore = edmHit.core();
-          fcc::DigiTrackHitAssociation edmDigiHit = edmDigiHits->create();
-          edmHitCore.cellId = hit->cellID;
-          edmHitCore.energy = hit->energyDeposit * sim::g42edm::energy;
-          edmHitCore.bits = hit->trackId;
-          edmHitCore.time = hit->time;
-          fcc::Point preStepPosition = fcc::Point();
-          preStepPosition.x = hit->prePos.x() * sim::g42edm::length;
-          preStepPosition.y = hit->prePos.y() * sim::g42edm::length;
-          preStepPosition.z = hit->prePos.z() * sim::g42edm::length;
-          fcc::Point postStepPosition = fcc::Point();
-          postStepPosition.x = hit->postPos.x() * sim::g42edm::length;
-          postStepPosition.y = hit->postPos.y() * sim::g42edm::length;
-          postStepPosition.z = hit->postPos.z() * sim::g42edm::length;
+    for (int iter_coll : m_collectionIDs) {
+      // the type of the collection was checked when resolving the IDs
+      auto collect = static_cast<G4THitsCollection<fcc::Geant4PreDigiTrackHit>*>(collections->GetHC(iter_coll));
+      if (collect == nullptr) {
+        continue;
+      }
+      if (msgLevel(MSG::DEBUG)) {
+        debug() << "\t" << collect->entries() << " hits are stored in a tracker collection #" << iter_coll << ": "
+                << collect->GetName() << endmsg;
+      }
+      for (const auto hit : *collect->GetVector()) {
+        fcc::TrackHit edmHit = edmHits->create();
+        fcc::BareHit& edmHitCore = edmHit.core();
+        edmHitCore.cellId = hit->cellID;
+        edmHitCore.energy = hit->energyDeposit * sim::g42edm::energy;
+        edmHitCore.bits = hit->trackId;
+        edmHitCore.time = hit->time;
+        fcc::Point preStepPosition;
+        preStepPosition.x = hit->prePos.x() * sim::g42edm::length;
+        preStepPosition.y = hit->prePos.y() * sim::g42edm::length;
+        preStepPosition.z = hit->prePos.z() * sim::g42edm::length;
+        fcc::Point postStepPosition;
+        postStepPosition.x = hit->postPos.x() * sim::g42edm::length;
+        postStepPosition.y = hit->postPos.y() * sim::g42edm::length;
+        postStepPosition.z = hit->postPos.z() * sim::g42edm::length;
 
-          fcc::PositionedTrackHit edmPositionedHit = edmPositions->create(preStepPosition, edmHitCore);
-          edmDigiHit.postStepPosition(postStepPosition);
-          edmDigiHit.hit(edmPositionedHit);
-          
-        }
+        fcc::PositionedTrackHit edmPositionedHit = edmPositions->create(preStepPosition, edmHitCore);
+        fcc::DigiTrackHitAssociation edmDigiHit = edmDigiHits->create();
+        edmDigiHit.postStepPosition(postStepPosition);
+        edmDigiHit.hit(edmPositionedHit);
       }
     }
   }
   return StatusCode::SUCCESS;
 }
+
+void SimG4SaveTrackerHits::resolveCollectionIDs(G4HCofThisEvent& aCollections) {
+  // collection IDs are fixed once the sensitive detectors are constructed, they do not change between events
+  m_collectionIDs.clear();
+  for (int iter_coll = 0; iter_coll < aCollections.GetNumberOfCollections(); iter_coll++) {
+    auto collect = aCollections.GetHC(iter_coll);
+    if (collect == nullptr) {
+      continue;
+    }
+    if (std::find(m_readoutNames.begin(), m_readoutNames.end(), collect->GetName()) == m_readoutNames.end()) {
+      continue;
+    }
+    if (dynamic_cast<G4THitsCollection<fcc::Geant4PreDigiTrackHit>*>(collect) == nullptr) {
+      warning() << "Collection " << collect->GetName() << " does not hold tracker hits, it will not be saved" << endmsg;
+      continue;
+    }
+    m_collectionIDs.push_back(iter_coll);
+  }
+  m_collectionIDsResolved = true;
+}
@@ -8,6 +8,7 @@
 #include "FWCore/DataHandle.h"
 #include "SimG4Interface/ISimG4SaveOutputTool.h"
 class IGeoSvc;
+class G4HCofThisEvent;
 
 // datamodel
 namespace fcc {
@@ -49,6 +50,11 @@ public:
   virtual StatusCode saveOutput(const G4Event& aEvent) final;
 
 private:
+  /** Find the hit collections of the readouts to save.
+   *  Called at the first event, as the collections are only known once the sensitive detectors are constructed.
+   *  @param[in] aCollections hit collections of the event
+   */
+  void resolveCollectionIDs(G4HCofThisEvent& aCollections);
   /// Pointer to the geometry service
   SmartIF<IGeoSvc> m_geoSvc;
   /// Handle for tracker hits
@@ -61,6 +67,10 @@ private:
   /// Name of the readouts (hits collections) to save
   Gaudi::Property<std::vector<std::string>> m_readoutNames{
       this, "readoutNames", {}, "Name of the readouts (hits collections) to save"};
+  /// IDs of the hit collections to save, in the order of the event collections
+  std::vector<int> m_collectionIDs;
+  /// Whether m_collectionIDs was filled
+  bool m_collectionIDsResolved = false;
 };
 
 #endif /* SIMG4COMPONENTS_G4SAVETRACKERHITS_H */
@@ -1,6 +1,7 @@
 #include "SimG4Svc.h"
 
 // Gaudi
+#include "GaudiKernel/IProperty.h"
 #include "GaudiKernel/IRndmEngine.h"
 #include "GaudiKernel/IToolSvc.h"
 
@@ -41,6 +42,24 @@ StatusCode SimG4Svc::initialize() {
     error() << "Unable to locate RndmGen Service" << endmsg;
     return StatusCode::FAILURE;
   }
+  // Only one Geant run manager can exist
+  G4RunManager* runManager = nullptr;
+  if (m_numThreads > 1) {
+    if (m_verticesPerSubEvent == 0) {
+      error() << "verticesPerSubEvent needs to be at least 1" << endmsg;
+      return StatusCode::FAILURE;
+    }
+    if (m_interactiveMode) {
+      error() << "Interactive mode is not available in the multithreaded simulation" << endmsg;
+      return StatusCode::FAILURE;
+    }
+    m_mtRunManager = std::make_unique<sim::MTRunManager>(m_numThreads, m_verticesPerSubEvent);
+    runManager = m_mtRunManager.get();
+    info() << "Simulating with " << m_numThreads << " Geant worker threads" << endmsg;
+  } else {
+    m_runManager = std::make_unique<sim::RunManager>();
+    runManager = m_runManager.get();
+  }
   if (!m_detectorTool.retrieve()) {
     error() << "Unable to retrieve detector construction" << endmsg;
     return StatusCode::FAILURE;
@@ -57,19 +76,35 @@ StatusCode SimG4Svc::initialize() {
     error() << "Unable to retrieve the magnetic field" << endmsg;
     return StatusCode::FAILURE;
   }
+  if (m_mtRunManager) {
+    // the field managers are thread-local, the field tool has set up the master thread only
+    m_mtRunManager->setMagneticField(m_magneticFieldTool.get());
+    // the worker threads only return the hits: user information of the events is not available
+    SmartIF<IProperty> actionsProperties(m_actionsTool.get());
+    bool historyEnabled = actionsProperties && actionsProperties->hasProperty("enableHistory") &&
+                          actionsProperties->getProperty("enableHistory").toString() == "True";
+    if (historyEnabled) {
+      error() << "The particle history is not available in the multithreaded simulation" << endmsg;
+      return StatusCode::FAILURE;
+    }
+    if (m_actionsTool.type() == "SimG4FastSimActions" || m_physicsListTool.type() == "SimG4FastSimPhysicsList") {
+      error() << "The fast simulation is not available in the multithreaded simulation" << endmsg;
+      return StatusCode::FAILURE;
+    }
+  }
 
   // Initialize Geant run manager
   // Load physics list, deleted in ~G4RunManager()
-  m_runManager.SetUserInitialization(m_physicsListTool->physicsList());
+  runManager->SetUserInitialization(m_physicsListTool->physicsList());
   // Take geometry (from DD4Hep), deleted in ~G4RunManager()
-  m_runManager.SetUserInitialization(m_detectorTool->detectorConstruction());
+  runManager->SetUserInitialization(m_detectorTool->detectorConstruction());
 
   G4UImanager* UImanager = G4UImanager::GetUIpointer();
   for (auto command : m_g4PreInitCommands) {
     UImanager->ApplyCommand(command);
   }
 
-  m_runManager.Initialize();
+  runManager->Initialize();
 
   if (m_interactiveMode) {
     m_visManager = std::make_unique<G4VisExecutive>();
@@ -80,7 +115,7 @@ StatusCode SimG4Svc::initialize() {
   }
 
   // Attach user actions
-  m_runManager.SetUserInitialization(m_actionsTool->userActionInitialization());
+  runManager->SetUserInitialization(m_actionsTool->userActionInitialization());
   if (!msgLevel(MSG::DEBUG)) {
     G4HadronicProcessStore::Instance()->SetVerbose(0);
     UImanager->ApplyCommand("/run/verbose 0");
@@ -106,6 +141,7 @@ StatusCode SimG4Svc::initialize() {
   }
 
   // configure the random service
+  // in the multithreaded simulation the seeds of each sub-event are drawn from this engine
   if (m_rndmFromGaudi) {
     std::vector<long> seedsVec;
     m_randSvc->engine()->seeds(seedsVec);
@@ -115,7 +151,8 @@ StatusCode SimG4Svc::initialize() {
   info() << "Random numbers seeds: " << CLHEP::HepRandom::getTheSeeds()[0] << "\t" << CLHEP::HepRandom::getTheSeeds()[1]
          << endmsg;
 
-  if (!m_runManager.start()) {
+  StatusCode started = m_mtRunManager ? m_mtRunManager->start() : m_runManager->start();
+  if (!started) {
     error() << "Unable to initialize GEANT correctly." << endmsg;
     return StatusCode::FAILURE;
   }
@@ -123,7 +160,7 @@ StatusCode SimG4Svc::initialize() {
 }
 
 StatusCode SimG4Svc::processEvent(G4Event& aEvent) {
-  bool status = m_runManager.processEvent(aEvent);
+  bool status = m_mtRunManager ? m_mtRunManager->processEvent(aEvent) : m_runManager->processEvent(aEvent);
   if (!status) {
     error() << "Unable to process event in Geant" << endmsg;
     return StatusCode::FAILURE;
@@ -131,14 +168,27 @@ StatusCode SimG4Svc::processEvent(G4Event& aEvent) {
   return StatusCode::SUCCESS;
 }
 
-StatusCode SimG4Svc::retrieveEvent(G4Event*& aEvent) { return m_runManager.retrieveEvent(aEvent); }
+StatusCode SimG4Svc::retrieveEvent(G4Event*& aEvent) {
+  if (m_mtRunManager) {
+    return m_mtRunManager->retrieveEvent(aEvent);
+  }
+  return m_runManager->retrieveEvent(aEvent);
+}
 
 StatusCode SimG4Svc::terminateEvent() {
-  m_runManager.terminateEvent();
+  if (m_mtRunManager) {
+    m_mtRunManager->terminateEvent();
+  } else {
+    m_runManager->terminateEvent();
+  }
   return StatusCode::SUCCESS;
 }
 
 StatusCode SimG4Svc::finalize() {
-  m_runManager.finalize();
+  if (m_mtRunManager) {
+    m_mtRunManager->finalize();
+  } else if (m_runManager) {
+    m_runManager->finalize();
+  }
   return Service::finalize();
 }
@@ -2,6 +2,7 @@
 #define SIMG4COMPONENTS_G4SIMSVC_H
 
 // FCCSW
+#include "MTRunManager.h"
 #include "SimG4Common/RunManager.h"
 #include "SimG4Interface/ISimG4ActionTool.h"
 #include "SimG4Interface/ISimG4DetectorConstruction.h"
@@ -24,6 +25,8 @@
  *
  *  Main Geant simulation service.
  *  It handles Geant initialization (via tools) and communication with the G4RunManager.
+ *  If numberOfThreads is larger than 1, the primary vertices of each event are simulated in sub-events
+ *  on Geant worker threads (G4MTRunManager), see sim::MTRunManager.
  *  [For more information please see](@ref md_sim_doc_geant4fullsim).
  *
  *  @author Anna Zaborowska
@@ -90,9 +93,17 @@ private:
   Gaudi::Property<bool> m_rndmFromGaudi{this, "randomNumbersFromGaudi", true, "Whether random numbers should be taken from Gaudi"};
 
   Gaudi::Property<bool> m_interactiveMode{this, "InteractiveMode", false, "Enter the interactive mode"};
+  /// Number of Geant worker threads, sequential G4RunManager if 1
+  Gaudi::Property<unsigned int> m_numThreads{this, "numberOfThreads", 1,
+                                             "Number of Geant worker threads (1: sequential simulation)"};
+  /// Number of primary vertices per sub-event in the multithreaded simulation
+  Gaudi::Property<unsigned int> m_verticesPerSubEvent{
+      this, "verticesPerSubEvent", 1, "Number of primary vertices simulated together on one worker thread"};
 
-  /// Run Manager
-  sim::RunManager m_runManager;
+  /// Run Manager, for the sequential simulation
+  std::unique_ptr<sim::RunManager> m_runManager;
+  /// Run Manager, for the multithreaded simulation
+  std::unique_ptr<sim::MTRunManager> m_mtRunManager;
 
   std::unique_ptr<G4VisManager> m_visManager{nullptr};
   // Define UI terminal for interactive mode
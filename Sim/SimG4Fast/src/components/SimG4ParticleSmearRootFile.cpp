@@ -2,7 +2,6 @@
 
 // Gaudi
 #include "GaudiKernel/DeclareFactoryEntries.h"
-#include "GaudiKernel/IRndmGen.h"
 #include "GaudiKernel/IRndmGenSvc.h"
 #include "GaudiKernel/SystemOfUnits.h"
 
@@ -15,6 +14,9 @@
 #include "CLHEP/Units/SystemOfUnits.h"
 #include "CLHEP/Vector/ThreeVector.h"
 
+#include <algorithm>
+#include <cmath>
+
 DECLARE_TOOL_FACTORY(SimG4ParticleSmearRootFile)
 
 SimG4ParticleSmearRootFile::SimG4ParticleSmearRootFile(const std::string& type, const std::string& name,
@@ -38,6 +40,10 @@ StatusCode SimG4ParticleSmearRootFile::initialize() {
     error() << "Couldn't read the input resolution file from tkLayout" << endmsg;
     return StatusCode::FAILURE;
   }
+  if (m_gauss.initialize(m_randSvc, Rndm::Gauss(0, 1)).isFailure()) {
+    error() << "Couldn't initialize the Gaussian random number generator" << endmsg;
+    return StatusCode::FAILURE;
+  }
   return StatusCode::SUCCESS;
 }
 
@@ -46,9 +52,7 @@ StatusCode SimG4ParticleSmearRootFile::finalize() { return GaudiTool::finalize()
 StatusCode SimG4ParticleSmearRootFile::smearMomentum(CLHEP::Hep3Vector& aMom, int /*aPdg*/) {
   double res = resolution(aMom.pseudoRapidity(), aMom.mag() / CLHEP::GeV);
   if (res > 0) {
-    m_randSvc->generator(Rndm::Gauss(1, res), m_gauss);
-    double tmp = m_gauss->shoot();
-    aMom *= tmp;
+    aMom *= 1 + res * m_gauss.shoot();
   }
   return StatusCode::SUCCESS;
 }
@@ -85,6 +89,11 @@ StatusCode SimG4ParticleSmearRootFile::readResolutions() {
   infoTree->GetEntry(0);
   int binsEta = readEta->GetSize();
   int binsP = readP->GetSize();
+  if (binsEta < 1 || binsP < 2) {
+    error() << "Resolution file " << m_resolutionFileName << " needs at least one eta bin and two momentum values"
+            << endmsg;
+    return StatusCode::FAILURE;
+  }
   m_minMomentum = readP->At(0);
   m_maxMomentum = readP->At(binsP - 1);
   m_maxEta = readEta->At(binsEta - 1);
@@ -103,9 +112,18 @@ StatusCode SimG4ParticleSmearRootFile::readResolutions() {
   }
   TArrayD* readRes = nullptr;
   resolutionTree->SetBranchAddress("resolution", &readRes);
+  m_etaEdges.assign(readEta->GetArray(), readEta->GetArray() + binsEta);
+  m_momenta.assign(readP->GetArray(), readP->GetArray() + binsP);
+  m_resolutions.clear();
+  m_resolutions.reserve(binsEta * binsP);
   for (int itEta = 0; itEta < binsEta; itEta++) {
     resolutionTree->GetEntry(itEta);
-    m_momentumResolutions[readEta->At(itEta)] = TGraph(binsP, readP->GetArray(), readRes->GetArray());
+    if (readRes->GetSize() != binsP) {
+      error() << "Resolution file " << m_resolutionFileName << " has " << readRes->GetSize()
+              << " resolutions for eta bin " << itEta << ", expected " << binsP << endmsg;
+      return StatusCode::FAILURE;
+    }
+    m_resolutions.insert(m_resolutions.end(), readRes->GetArray(), readRes->GetArray() + binsP);
     if (msgLevel(MSG::DEBUG)) {
       debug() << "resolutions for eta (" << (itEta == 0 ? 0 : readEta->At(itEta - 1)) << ", " << readEta->At(itEta)
               << "): \n";
@@ -121,13 +139,15 @@ StatusCode SimG4ParticleSmearRootFile::readResolutions() {
 
 double SimG4ParticleSmearRootFile::resolution(double aEta, double aMom) {
   // smear particles only in the pseudorapidity region where resolutions are defined
-  if (fabs(aEta) > m_maxEta) return 0;
-  for (auto& m : m_momentumResolutions) {
-    if (fabs(aEta) < m.first) {
-      return m.second.Eval(aMom);
-    }
-  }
-  return 0;
+  auto etaEdge = std::upper_bound(m_etaEdges.begin(), m_etaEdges.end(), std::fabs(aEta));
+  if (etaEdge == m_etaEdges.end()) return 0;
+  const double* res = m_resolutions.data() + (etaEdge - m_etaEdges.begin()) * m_momenta.size();
+  // linear interpolation between the closest momentum values, extrapolation from the first or last two outside
+  size_t iP = std::upper_bound(m_momenta.begin(), m_momenta.end(), aMom) - m_momenta.begin();
+  iP = std::min(std::max(iP, size_t(1)), m_momenta.size() - 1);
+  const double p0 = m_momenta[iP - 1];
+  const double p1 = m_momenta[iP];
+  return res[iP - 1] + (aMom - p0) * (res[iP] - res[iP - 1]) / (p1 - p0);
 }
 
 StatusCode SimG4ParticleSmearRootFile::checkConditions(double aMinMomentum, double aMaxMomentum, double aMaxEta) const {
@@ -5,10 +5,6 @@
 #include "GaudiAlg/GaudiTool.h"
 #include "GaudiKernel/RndmGenerators.h"
 class IRndmGenSvc;
-class IRndmGen;
-
-// ROOT
-#include "TGraph.h"
 
 // FCCSW
 #include "SimG4Interface/ISimG4ParticleSmearTool.h"
@@ -22,6 +18,9 @@ class IRndmGen;
  *  'resolutions' tree has TArrayD with resolutions computed for momentum values. An array is defined for every eta bin.
  *  Momentum of the particle is smeared following a Gaussian distribution,
  *  using the evaluated resolution as the mean.
+ *  At initialization the resolutions are stored in a flat (eta bin, momentum) table. The resolution of a particle is
+ *  constant within an eta bin and linearly interpolated in momentum (as TGraph::Eval), so that the lookup is two
+ *  binary searches in short arrays and one interpolation.
  *  User needs to specify the min/max momentum nad max eta for fast sim in the `SimG4FastSimTrackerRegion` tool.
  *  The defined values cannot be broader than eta and p values for which the resolutions were computed.
  *
@@ -70,11 +69,14 @@ public:
 private:
   /// Random Number Service
   SmartIF<IRndmGenSvc> m_randSvc;
-  /// Gaussian random number generator used for smearing with a constant resolution (m_sigma)
-  IRndmGen* m_gauss;
-  /// Map of p-dependent resolutions and the end of eta bin that it refers to
-  /// (lower end is defined by previous entry, and eta=0 for the first one)
-  std::map<double, TGraph> m_momentumResolutions;
+  /// Standard normal random number generator, scaled by the resolution
+  Rndm::Numbers m_gauss;
+  /// Upper edges of the eta bins (lower end is defined by previous entry, and eta=0 for the first one)
+  std::vector<double> m_etaEdges;
+  /// Momentum values for which the resolutions are defined, in increasing order
+  std::vector<double> m_momenta;
+  /// Resolutions, indexed by [eta bin * number of momentum values + momentum index]
+  std::vector<double> m_resolutions;
   /// File name with the resolutions obtained from root file (set by job options)
   Gaudi::Property<std::string> m_resolutionFileName{this, "filename", "",
                                                     "File name with the resolutions obtained from root file"};
@@ -6,6 +6,7 @@
 /** @class ParticleHistoryEventAction SimG4Full/SimG4Full/ParticleHistoryEventAction.h ParticleHistoryEventAction.h
  *
  *  User event action that creates the EventInformation class that holds information on secondaries
+ *  The largest number of saved secondaries seen so far is used to reserve the lookup tables of the next events.
  *
  *  @author V. Volkl
  */
@@ -18,9 +19,12 @@ public:
 
   /// EventInformation data structure is created here
   virtual void  BeginOfEventAction ( const G4Event *anEvent);
-  /// empty action 
+  /// Updates the number of secondaries expected in the next events
   virtual void  EndOfEventAction (const G4Event *anEvent);
 
+private:
+  /// Largest number of secondaries saved in an event so far
+  size_t m_expectedParticles = 0;
 };
 }
 
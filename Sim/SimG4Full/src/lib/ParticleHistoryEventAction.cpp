@@ -6,16 +6,23 @@
 #include "G4LorentzVector.hh"
 #include "G4Event.hh"
 
+#include <algorithm>
+
 namespace sim {
 
 ParticleHistoryEventAction::ParticleHistoryEventAction() {}
 
 void  ParticleHistoryEventAction::BeginOfEventAction (const G4Event * /*anEvent*/) {
 
-  auto eventInfo = new sim::EventInformation();
+  auto eventInfo = new sim::EventInformation(m_expectedParticles);
   G4EventManager::GetEventManager()->SetUserInformation(eventInfo);
 }
   
-void  ParticleHistoryEventAction::EndOfEventAction (const G4Event * /*anEvent*/) {}
+void  ParticleHistoryEventAction::EndOfEventAction (const G4Event * anEvent) {
+  auto eventInfo = dynamic_cast<sim::EventInformation*>(anEvent->GetUserInformation());
+  if (eventInfo != nullptr) {
+    m_expectedParticles = std::max(m_expectedParticles, eventInfo->numParticles());
+  }
+}
 
 }
@@ -19,12 +19,18 @@
 
 class ISimG4MagneticFieldTool : virtual public IAlgTool {
 public:
-  DeclareInterfaceID(ISimG4MagneticFieldTool, 1, 0);
+  DeclareInterfaceID(ISimG4MagneticFieldTool, 2, 0);
 
   /** get initialization hook for the magnetic field
    *  @return pointer to G4MagneticField
    */
   virtual const G4MagneticField* field() const = 0;
+
+  /** Install the field in the field manager of the calling thread.
+   *  The Geant4 transportation manager is thread-local: the master thread is set up when the tool is initialized,
+   *  in the multithreaded simulation this is called on each worker thread.
+   */
+  virtual void installField() const = 0;
 };
 
 #endif /* SIMG4INTERFACE_ISIM4MAGNETICFIELDTOOL_H */